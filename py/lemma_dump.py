@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+# NLTK WordNet → wordnet_lemma.txt (C++ Lemmatizer 의 표 원본)
+#   python lemma_dump.py [--out wordnet_lemma.txt]
+# 비교용 기준 출력 (단어<tab>lemmatize_list.lemma_of 결과):
+#   python lemma_dump.py --ref vocab.txt --ref-out lemma_ref.tsv
+#   epub2vocab --check-lemma lemma_ref.tsv
+# 테스트 데이터 (src/functions/lemmatizer/test/): 단어 목록이 morphy 중에 조회할 수 있는 항목만 담은 작은 표
+#   python lemma_dump.py --words lemma_words.txt --out wordnet_lemma_subset.txt
+#   python lemma_dump.py --ref lemma_words.txt --ref-out lemma_ref.tsv
+#
+# 만들어진 wordnet_lemma.txt 를 exe 옆(또는 src/functions/lemmatizer/)에 두면
+# 첫 실행 때 wordnet_lemma.bin 이미지가 생성되고 이후에는 mmap 으로 바로 쓴다.
+import sys
+import argparse
+from pathlib import Path
+from nltk.corpus import wordnet as wn
+
+POS = "nvar"
+
+def reachable(words):
+    """morphy 가 words 를 분석하면서 색인에서 찾아볼 수 있는 문자열 전부 (원형, 예외 원형, 규칙 적용 결과)"""
+    keys = set()
+    for w in words:
+        keys.add(w)
+        for p in POS:
+            keys.update(wn._exception_map[p].get(w, []))
+            keys.update(w[: -len(old)] + new for old, new in wn.MORPHOLOGICAL_SUBSTITUTIONS[p] if w.endswith(old))
+    return keys
+
+def dump_table(out_path: Path, words=None):
+    wn.ensure_loaded()
+    index = wn._lemma_pos_offset_map
+    keys = reachable(words) if words is not None else None
+    forms = set(words) if words is not None else None
+    lines = ["# epub2vocab WordNet morphy table (py/lemma_dump.py)"]
+    for lemma in sorted(index):
+        if keys is not None and lemma not in keys:
+            continue
+        pos = "".join(p for p in POS if p in index[lemma])
+        if pos and "\t" not in lemma:
+            lines.append(f"L\t{lemma}\t{pos}")
+    for p in POS:
+        exc = wn._exception_map[p]
+        for form in sorted(exc):
+            if forms is not None and form not in forms:
+                continue
+            lines.append("\t".join(["E", p, form] + list(exc[form])))
+    out_path.write_text("\n".join(lines) + "\n", encoding="utf-8", newline="\n")
+    print(f"[ok] saved {len(lines) - 1} records → {out_path}")
+
+def dump_ref(vocab: Path, out_path: Path):
+    sys.path.insert(0, str(Path(__file__).resolve().parent))
+    from lemmatize_list import read_words, lemma_of
+    words = read_words(vocab)
+    text = "".join(f"{w}\t{lemma_of(w)}\n" for w in words)
+    out_path.write_text(text, encoding="utf-8", newline="\n")
+    print(f"[ok] saved {len(words)} reference lemmas → {out_path}")
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--out", default="wordnet_lemma.txt", help="표 출력 경로")
+    ap.add_argument("--ref", default="", help="기준 lemma 를 만들 vocab.txt")
+    ap.add_argument("--ref-out", default="lemma_ref.tsv", help="기준 출력 경로")
+    ap.add_argument("--words", default="", help="이 단어들에 필요한 항목만 표에 담음 (테스트용)")
+    args = ap.parse_args()
+
+    if args.ref:
+        dump_ref(Path(args.ref), Path(args.ref_out))
+    elif args.words:
+        sys.path.insert(0, str(Path(__file__).resolve().parent))
+        from lemmatize_list import read_words
+        dump_table(Path(args.out), read_words(Path(args.words)))
+    else:
+        dump_table(Path(args.out))
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+# 네트워크 없이 사전 조회를 돌려 보기 위한 로컬 Merriam-Webster 흉내 서버
+#   python mock_dictionary_server.py [--port 18777] [--delay 0.5] [--fail-rate 0.3] [--retry-after 1] [--seed 1]
+# exe 옆 .env 에 아래를 넣으면 epub2vocab 이 이 서버로 요청한다:
+#   DICTIONARY_KEY=test
+#   DICTIONARY_API_URL=http://127.0.0.1:18777/json/
+# "zz" 로 시작하는 단어는 제안 목록(문자열 배열), "none" 으로 시작하면 빈 배열을 돌려준다.
+# --fail-rate 를 주면 그 비율만큼 쿼터 초과(429, HTML 본문)나 503 을 섞어 돌려준다 (재시도/속도 제한 확인용).
+#   --seed 를 주면 실패 여부가 (단어, 그 단어의 몇 번째 요청) 로 정해진다 (스레드 순서와 무관하게 재현 가능)
+# ?delay=초 를 붙이면 그 요청만 지연을 바꾼다 (응답 순서 뒤섞기용).
+# GET /stats       : {"requests", "failures", "in_flight", "max_in_flight"} (사전 요청만 셈)
+# GET /stats/reset : 위 통계를 0 으로
+#
+# 테스트용 실행: --port 0 이면 빈 포트를 쓰고, --run 뒤의 명령을 EPUB2VOCAB_MOCK_URL=http://127.0.0.1:<port>/json/
+# 환경 변수와 함께 실행한 뒤 그 종료 코드로 끝난다 (ctest 의 http_multi 테스트가 이렇게 쓴다)
+#   python mock_dictionary_server.py --port 0 --delay 0 --run ./http_multi_test
+import os
+import sys
+import json
+import random
+import subprocess
+import threading
+import time
+import argparse
+import http.server
+import socketserver
+import urllib.parse
+
+ERROR_PAGE = b"<html><body><h1>Key limit exceeded</h1></body></html>"
+
+class Stats:
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.attempts = {}      # 단어 → 받은 요청 수 (--seed 용)
+        self.reset()
+
+    def reset(self):
+        with self.lock:
+            self.requests = self.failures = self.in_flight = self.max_in_flight = 0
+
+    def snapshot(self):
+        with self.lock:
+            return {"requests": self.requests, "failures": self.failures,
+                    "in_flight": self.in_flight, "max_in_flight": self.max_in_flight}
+
+def make_handler(delay, fail_rate, retry_after, seed, stats):
+    class Handler(http.server.BaseHTTPRequestHandler):
+        protocol_version = "HTTP/1.1"   # keep-alive
+
+        def send_json(self, status, body):
+            data = json.dumps(body).encode("utf-8")
+            self.send_response(status)
+            self.send_header("Content-Type", "application/json")
+            self.send_header("Content-Length", str(len(data)))
+            self.end_headers()
+            self.wfile.write(data)
+
+        def should_fail(self, word):
+            if fail_rate <= 0:
+                return False
+            if seed is None:
+                return random.random() < fail_rate
+            with stats.lock:
+                n = stats.attempts.get(word, 0)
+                stats.attempts[word] = n + 1
+            return random.Random(f"{seed}:{word}:{n}").random() < fail_rate
+
+        def do_GET(self):
+            url = urllib.parse.urlsplit(self.path)
+            if url.path == "/stats":
+                return self.send_json(200, stats.snapshot())
+            if url.path == "/stats/reset":
+                stats.reset()
+                return self.send_json(200, stats.snapshot())
+
+            word = url.path.rsplit("/", 1)[-1]
+            query = urllib.parse.parse_qs(url.query)
+            wait = float(query["delay"][0]) if "delay" in query else delay
+            with stats.lock:
+                stats.requests += 1
+                stats.in_flight += 1
+                stats.max_in_flight = max(stats.max_in_flight, stats.in_flight)
+            try:
+                time.sleep(wait)
+                failed = self.should_fail(word)
+                if failed:
+                    with stats.lock:
+                        stats.failures += 1
+            finally:
+                with stats.lock:
+                    stats.in_flight -= 1
+
+            if failed:
+                status = random.Random(f"{seed}:{word}").choice([429, 429, 503]) if seed is not None \
+                    else random.choice([429, 429, 503])
+                self.send_response(status)
+                if status == 429 and retry_after > 0:
+                    self.send_header("Retry-After", str(retry_after))
+                self.send_header("Content-Type", "text/html")
+                self.send_header("Content-Length", str(len(ERROR_PAGE)))
+                self.end_headers()
+                self.wfile.write(ERROR_PAGE)
+                return
+            if word.startswith("zz"):
+                body = [word[2:] or "zebra", "zebra"]
+            elif word.startswith("none"):
+                body = []
+            else:
+                body = [{"hwi": {"hw": word}, "fl": "noun",
+                         "shortdef": [f"mock definition of {word}"]}]
+            self.send_json(200, body)
+
+        def log_message(self, fmt, *args):
+            sys.stderr.write("[mock] %.3f %s\n" % (time.time(), self.path))
+    return Handler
+
+class Server(socketserver.ThreadingMixIn, http.server.HTTPServer):
+    daemon_threads = True
+    request_queue_size = 128
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--port", type=int, default=18777, help="0 이면 빈 포트")
+    ap.add_argument("--delay", type=float, default=0.5, help="응답 지연(초)")
+    ap.add_argument("--fail-rate", type=float, default=0.0, help="429/503 을 돌려줄 비율 (0~1)")
+    ap.add_argument("--retry-after", type=int, default=0, help="429 에 붙일 Retry-After(초), 0 이면 안 붙임")
+    ap.add_argument("--seed", type=int, default=None, help="실패 여부를 (단어, 시도 횟수) 로 고정")
+    ap.add_argument("--run", nargs=argparse.REMAINDER, help="서버를 띄운 채 이 명령을 실행하고 그 종료 코드로 끝냄")
+    args = ap.parse_args()
+
+    stats = Stats()
+    server = Server(("127.0.0.1", args.port),
+                    make_handler(args.delay, args.fail_rate, args.retry_after, args.seed, stats))
+    url = f"http://127.0.0.1:{server.server_address[1]}/json/"
+    print(f"[mock] listening on {url}", file=sys.stderr)
+    if not args.run:
+        server.serve_forever()
+        return 0
+
+    threading.Thread(target=server.serve_forever, daemon=True).start()
+    env = dict(os.environ, EPUB2VOCAB_MOCK_URL=url)
+    rc = subprocess.call(args.run, env=env)
+    server.shutdown()
+    return rc
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,187 @@
+#!/usr/bin/env python3
+# 텔레그램 Bot API 없이 전송기를 돌려 보기 위한 로컬 sendMessage 흉내 서버
+#   python mock_telegram_server.py [--port 18780] [--fail-rate 0.2] [--retry-after 1] [--min-interval 1.0] [--seed 1]
+# exe 옆 .env 에 아래를 넣으면 epub2vocab 이 이 서버로 보낸다:
+#   TELEGRAM_API_KEY=test
+#   TELEGRAM_CHAT_ID=1
+#   TELEGRAM_API_URL=http://127.0.0.1:18780
+# 받은 메시지마다 연결(클라이언트 포트), 길이, UTF-8 유효성, 같은 채팅 직전 메시지와의 간격을 출력한다.
+# --fail-rate 비율만큼 429(retry_after) / 502 를 섞어 돌려준다. 4096자(UTF-16 단위)를 넘으면 400.
+#   --seed 를 주면 실패 여부가 (본문, 그 본문의 몇 번째 요청) 로 정해진다 (재현 가능)
+# GET /fail?status=429&count=2&retry_after=1 : 다음 count 개의 sendMessage 에 그 상태를 돌려준다 (--fail-rate 보다 먼저)
+# GET /messages    : 받아들인(200) 메시지 [{"chat", "text", "t"}] (t = 서버 단조 시계, 초)
+# GET /stats       : {"requests", "failures", "sent", "by_status": {"429": n, ...}}
+# GET /stats/reset : 위 통계, 메시지 목록, /fail 예약을 모두 비움
+#
+# 테스트용 실행: --port 0 이면 빈 포트를 쓰고, --run 뒤의 명령을 EPUB2VOCAB_TELEGRAM_URL=http://127.0.0.1:<port>
+# 환경 변수와 함께 실행한 뒤 그 종료 코드로 끝난다 (ctest 의 telegram_sender_http 테스트가 이렇게 쓴다)
+#   python mock_telegram_server.py --port 0 --run ./telegram_sender_test --gtest_filter=TelegramHttp.*
+import os
+import sys
+import json
+import time
+import random
+import argparse
+import subprocess
+import threading
+import http.server
+import socketserver
+import urllib.parse
+
+def utf16_units(s):
+    return sum(2 if ord(c) > 0xFFFF else 1 for c in s)
+
+class State:
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.reset()
+
+    def reset(self):
+        with self.lock:
+            self.requests = self.failures = 0
+            self.by_status = {}
+            self.messages = []
+            self.last = {}          # 채팅 → 마지막 수신 시각
+            self.attempts = {}      # 본문 → 받은 요청 수 (--seed 용)
+            self.script = []        # /fail 로 예약한 (status, retry_after)
+            self.next_id = 0
+
+    def snapshot(self):
+        with self.lock:
+            return {"requests": self.requests, "failures": self.failures, "sent": len(self.messages),
+                    "by_status": {str(k): v for k, v in self.by_status.items()}}
+
+def make_handler(args, state):
+    class Handler(http.server.BaseHTTPRequestHandler):
+        protocol_version = "HTTP/1.1"   # keep-alive
+
+        def reply(self, status, body):
+            data = json.dumps(body).encode("utf-8")
+            self.send_response(status)
+            self.send_header("Content-Type", "application/json")
+            self.send_header("Content-Length", str(len(data)))
+            self.end_headers()
+            self.wfile.write(data)
+            with state.lock:
+                state.by_status[status] = state.by_status.get(status, 0) + 1
+
+        def fail_with(self, status, retry_after):
+            with state.lock:
+                state.failures += 1
+            if status == 429:
+                return self.reply(429, {"ok": False, "error_code": 429,
+                                        "description": f"Too Many Requests: retry after {retry_after}",
+                                        "parameters": {"retry_after": retry_after}})
+            description = "Bad Gateway" if status == 502 else f"Mock error {status}"
+            return self.reply(status, {"ok": False, "error_code": status, "description": description})
+
+        # 이번 요청을 실패시킬지: (상태, retry_after) 또는 None
+        def planned_failure(self, text):
+            with state.lock:
+                if state.script:
+                    return state.script.pop(0)
+                n = state.attempts.get(text, 0)
+                state.attempts[text] = n + 1
+            if args.fail_rate <= 0:
+                return None
+            rng = random.Random(f"{args.seed}:{text}:{n}") if args.seed is not None else random
+            if rng.random() >= args.fail_rate:
+                return None
+            return (429 if rng.random() < 0.7 else 502), args.retry_after
+
+        def do_GET(self):
+            url = urllib.parse.urlsplit(self.path)
+            query = urllib.parse.parse_qs(url.query)
+            if url.path == "/stats":
+                return self.reply(200, state.snapshot())
+            if url.path == "/stats/reset":
+                state.reset()
+                return self.reply(200, state.snapshot())
+            if url.path == "/messages":
+                with state.lock:
+                    messages = list(state.messages)
+                return self.reply(200, messages)
+            if url.path == "/fail":
+                status = int(query.get("status", ["502"])[0])
+                count = int(query.get("count", ["1"])[0])
+                retry_after = int(query.get("retry_after", [str(args.retry_after)])[0])
+                with state.lock:
+                    state.script = [(status, retry_after)] * count
+                return self.reply(200, {"ok": True})
+            return self.reply(404, {"ok": False, "error_code": 404, "description": "Not Found"})
+
+        def do_POST(self):
+            raw = self.rfile.read(int(self.headers.get("Content-Length", 0)))
+            if not self.path.endswith("/sendMessage"):
+                return self.reply(404, {"ok": False, "error_code": 404, "description": "Not Found"})
+            with state.lock:
+                state.requests += 1
+
+            form = parse_qs_safe(raw)
+            chat = form.get("chat_id", [""])[0]
+            text, valid = form.get("text", [""])[0], form.get("valid", True)
+            failure = self.planned_failure(text)
+            if failure:
+                return self.fail_with(*failure)
+
+            now = time.monotonic()
+            with state.lock:
+                gap = now - state.last.get(chat, 0.0)
+                state.last[chat] = now
+            units = utf16_units(text)
+            print(json.dumps({"port": self.client_address[1], "chat": chat, "units": units,
+                              "utf8": valid, "gap": round(gap, 3),
+                              "too_fast": gap < args.min_interval, "head": text[:30]},
+                             ensure_ascii=False), flush=True)
+            if not valid or not text.strip() or units > 4096:
+                return self.reply(400, {"ok": False, "error_code": 400,
+                                        "description": "Bad Request: message text is empty or too long"})
+            with state.lock:
+                state.messages.append({"chat": chat, "text": text, "t": now})
+                state.next_id += 1
+                message_id = state.next_id
+            self.reply(200, {"ok": True, "result": {"message_id": message_id}})
+
+        def log_message(self, fmt, *a):
+            pass
+    return Handler
+
+# chat_id/text 폼. 본문이 올바른 UTF-8 이 아니면 valid=False
+def parse_qs_safe(raw):
+    body = raw.decode("ascii", errors="replace")
+    try:
+        form = urllib.parse.parse_qs(body, keep_blank_values=True, errors="strict")
+        form["valid"] = True
+    except UnicodeDecodeError:
+        form = urllib.parse.parse_qs(body, keep_blank_values=True, errors="replace")
+        form["valid"] = False
+    return form
+
+class Server(socketserver.ThreadingMixIn, http.server.HTTPServer):
+    daemon_threads = True
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--port", type=int, default=18780, help="0 이면 빈 포트")
+    ap.add_argument("--fail-rate", type=float, default=0.0)
+    ap.add_argument("--retry-after", type=int, default=1)
+    ap.add_argument("--min-interval", type=float, default=1.0, help="같은 채팅 간격 경고 기준(초)")
+    ap.add_argument("--seed", type=int, default=None, help="실패 여부를 (본문, 시도 횟수) 로 고정")
+    ap.add_argument("--run", nargs=argparse.REMAINDER, help="서버를 띄운 채 이 명령을 실행하고 그 종료 코드로 끝냄")
+    args = ap.parse_args()
+
+    server = Server(("127.0.0.1", args.port), make_handler(args, State()))
+    url = f"http://127.0.0.1:{server.server_address[1]}"
+    print(f"[mock] listening on {url}", file=sys.stderr)
+    if not args.run:
+        server.serve_forever()
+        return 0
+
+    threading.Thread(target=server.serve_forever, daemon=True).start()
+    env = dict(os.environ, EPUB2VOCAB_TELEGRAM_URL=url)
+    rc = subprocess.call(args.run, env=env)
+    server.shutdown()
+    return rc
+
+if __name__ == "__main__":
+    sys.exit(main())
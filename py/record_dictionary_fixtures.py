@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+# 사전 API 응답을 그대로 파일로 녹화 (epub2vocab --bench-json <dir> 의 입력)
+#   python record_dictionary_fixtures.py --env ../build/.env --out fixtures  run set go abandon
+#   python record_dictionary_fixtures.py --env ../build/.env --out fixtures --words vocab_lemma.txt --limit 50
+# .env 의 DICTIONARY_KEY / DICTIONARY_API_URL 을 epub2vocab 과 같은 방식으로 읽는다.
+# 결과: <out>/<word>.json (응답 바이트 그대로, 이미 있으면 건너뜀)
+import os
+import sys
+import time
+import argparse
+import urllib.parse
+import urllib.request
+
+DEFAULT_API_URL = "https://www.dictionaryapi.com/api/v3/references/collegiate/json/"
+
+def load_env(path):
+    env = {}
+    with open(path, encoding="utf-8") as f:
+        for line in f:
+            line = line.rstrip("\r\n")
+            if not line or line.startswith("#") or "=" not in line:
+                continue
+            key, val = line.split("=", 1)
+            env[key] = val
+    return env
+
+def read_words(path, limit):
+    words = []
+    with open(path, encoding="utf-8") as f:
+        for i, line in enumerate(f):
+            w = line.strip()
+            if not w or (i == 0 and w.isdigit()):   # vocab_lemma.txt 첫 줄은 단어 개수
+                continue
+            words.append(w)
+            if limit and len(words) >= limit:
+                break
+    return words
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--env", default=".env")
+    ap.add_argument("--out", default="fixtures")
+    ap.add_argument("--words", help="단어 목록 파일 (한 줄에 하나)")
+    ap.add_argument("--limit", type=int, default=0)
+    ap.add_argument("--delay", type=float, default=0.2, help="요청 사이 대기(초)")
+    ap.add_argument("word", nargs="*")
+    args = ap.parse_args()
+
+    env = load_env(args.env)
+    key = env.get("DICTIONARY_KEY", "")
+    if not key:
+        sys.exit("DICTIONARY_KEY is not set in " + args.env)
+    api = env.get("DICTIONARY_API_URL") or DEFAULT_API_URL
+
+    words = list(args.word)
+    if args.words:
+        words += read_words(args.words, args.limit)
+    if not words:
+        sys.exit("no words given")
+
+    os.makedirs(args.out, exist_ok=True)
+    saved = 0
+    for w in words:
+        path = os.path.join(args.out, w + ".json")
+        if os.path.exists(path):
+            continue
+        url = api + urllib.parse.quote(w) + "?key=" + urllib.parse.quote(key)
+        try:
+            with urllib.request.urlopen(url, timeout=30) as r:
+                data = r.read()
+        except Exception as e:
+            print(f"[warn] {w}: {e}", file=sys.stderr)
+            continue
+        with open(path, "wb") as f:
+            f.write(data)
+        saved += 1
+        time.sleep(args.delay)
+    print(f"saved {saved} responses to {args.out}")
+
+if __name__ == "__main__":
+    main()
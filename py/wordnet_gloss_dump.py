@@ -0,0 +1,56 @@
+#!/usr/bin/env python3
+# NLTK WordNet 뜻풀이 → dictionary.jsonl (오프라인 사전 덤프, C++ OfflineDictionary 의 원본)
+#   python wordnet_gloss_dump.py [--out dictionary.jsonl] [--max-defs 3]
+#
+# 한 줄 = 표제어 하나의 Merriam-Webster 모양 응답:
+#   [{"meta": {"id": "run:1"}, "hwi": {"hw": "run"}, "fl": "verb", "shortdef": ["...", ...]}, ...]
+# 품사마다 entry 하나 (명사, 동사, 형용사, 부사 순), shortdef 는 synset 뜻풀이 앞 max-defs 개.
+# MW 덤프(같은 모양의 JSON lines)가 있으면 그것을 그대로 dictionary.jsonl 로 써도 된다.
+#
+# 만들어진 dictionary.jsonl 을 exe 옆에 두면 첫 실행 때 dictionary.bin 이미지가 생성되고
+# 이후에는 mmap 으로 바로 조회한다 (.env 의 DICTIONARY_BACKEND=offline|http|auto).
+import json
+import argparse
+from pathlib import Path
+from nltk.corpus import wordnet as wn
+
+POS_ORDER = [("n", "noun"), ("v", "verb"), ("a", "adjective"), ("r", "adverb")]
+
+def entries_for(lemma, max_defs):
+    out = []
+    for pos, label in POS_ORDER:
+        synsets = wn.synsets(lemma, pos=pos)
+        if pos == "a":
+            synsets += [s for s in wn.synsets(lemma, pos="s") if s not in synsets]
+        defs = []
+        for s in synsets:
+            d = s.definition()
+            if d and d not in defs:
+                defs.append(d)
+            if len(defs) >= max_defs:
+                break
+        if defs:
+            out.append({"meta": {"id": f"{lemma}:{len(out) + 1}"},
+                        "hwi": {"hw": lemma}, "fl": label, "shortdef": defs})
+    return out
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--out", default="dictionary.jsonl")
+    ap.add_argument("--max-defs", type=int, default=3)
+    args = ap.parse_args()
+
+    wn.ensure_loaded()
+    lemmas = sorted({name.replace("_", " ").lower() for name in wn.all_lemma_names()})
+    n = 0
+    with Path(args.out).open("w", encoding="utf-8", newline="\n") as f:
+        for lemma in lemmas:
+            entries = entries_for(lemma, args.max_defs)
+            if not entries:
+                continue
+            f.write(json.dumps(entries, ensure_ascii=False) + "\n")
+            n += 1
+    print(f"[ok] saved {n} headwords → {args.out}")
+
+if __name__ == "__main__":
+    main()
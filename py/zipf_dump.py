@@ -0,0 +1,40 @@
+#!/usr/bin/env python3
+# wordfreq → zipf_en.txt (C++ ZipfTable 의 표 원본)
+#   python zipf_dump.py [--words words.txt ...] [--out zipf_en.txt]
+#
+# wordfreq 영어 목록 전체 + (선택) 추가 단어 파일(words.txt, vocab_lemma.txt 등)의 단어마다
+# zipf_frequency(word, "en") 을 기록한다. 하이픈/아포스트로피 단어는 wordfreq 가 토큰을
+# 합쳐 계산하므로 C++ 쪽과 같은 값을 쓰려면 사전 파일을 --words 로 같이 넘기는 게 좋다.
+# 만들어진 파일을 exe 옆(또는 src/functions/zipf_filter/)에 두면 첫 실행 때 .bin 이미지가 생긴다.
+import sys
+import argparse
+from pathlib import Path
+from wordfreq import zipf_frequency, iter_wordlist
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--words", nargs="*", default=[], help="추가로 넣을 줄당 1단어 파일들")
+    ap.add_argument("--out", default="zipf_en.txt", help="출력 파일 경로")
+    ap.add_argument("--lang", default="en", help="wordfreq 언어 코드")
+    args = ap.parse_args()
+
+    words = set(w for w in iter_wordlist(args.lang) if "\t" not in w and "\n" not in w)
+    for path in args.words:
+        for ln in Path(path).read_text(encoding="utf-8", errors="ignore").splitlines():
+            ln = ln.strip().lower()
+            if ln and "\t" not in ln:
+                words.add(ln)
+
+    lines = ["# epub2vocab zipf table (py/zipf_dump.py)"]
+    for w in sorted(words):
+        z = zipf_frequency(w, args.lang)
+        if z > 0:
+            lines.append(f"{w}\t{z:.2f}")
+
+    out = Path(args.out)
+    out.write_text("\n".join(lines) + "\n", encoding="utf-8", newline="\n")
+    print(f"[ok] saved {len(lines) - 1} words → {out}")
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,169 @@
+#include "batch_runner.hpp"
+#include "../../epub_reader/src/epub_reader.hpp"
+#include "../../word_extractor/src/word_extractor.hpp"
+#include "../../lemmatizer/src/lemmatizer.hpp"
+#include "../../book_cache/src/book_cache.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#ifdef _WIN32
+  #include <windows.h>
+#endif
+
+namespace fs = std::filesystem;
+
+static fs::path exe_dir() {
+#ifdef _WIN32
+    wchar_t buf[MAX_PATH];
+    DWORD n = GetModuleFileNameW(nullptr, buf, MAX_PATH);
+    return n ? fs::path(buf).parent_path() : fs::current_path();
+#else
+    return fs::current_path();
+#endif
+}
+
+static bool has_epub_ext(const fs::path& p) {
+    std::string ext = p.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c){ return (char)std::tolower(c); });
+    return ext == ".epub";
+}
+
+std::vector<fs::path> collect_epubs(const fs::path& dir_or_list) {
+    std::vector<fs::path> books;
+
+    if (fs::is_directory(dir_or_list)) {
+        for (const auto& e : fs::recursive_directory_iterator(dir_or_list)) {
+            if (e.is_regular_file() && has_epub_ext(e.path())) books.push_back(e.path());
+        }
+    } else {
+        // 파일 목록: 줄당 경로 1개, 빈 줄/# 주석 무시, 상대경로는 목록 파일 기준
+        std::ifstream in(dir_or_list);
+        if (!in) throw std::runtime_error("cannot open book list: " + dir_or_list.string());
+        const fs::path base = dir_or_list.parent_path();
+        std::string line;
+        while (std::getline(in, line)) {
+            while (!line.empty() && (line.back() == '\r' || line.back() == ' ' || line.back() == '\t')) line.pop_back();
+            if (line.empty() || line[0] == '#') continue;
+            fs::path p = fs::u8path(line);
+            books.push_back(p.is_relative() ? base / p : p);
+        }
+    }
+
+    std::sort(books.begin(), books.end());
+    return books;
+}
+
+int run_batch(const std::vector<fs::path>& books, const BatchOptions& opt) {
+    using Clock = std::chrono::steady_clock;
+    const auto t0 = Clock::now();
+
+    const fs::path out_dir = opt.out_dir.empty() ? exe_dir() / "batch" : opt.out_dir;
+    fs::create_directories(out_dir);
+
+    unsigned workers = opt.workers ? opt.workers : std::max(1u, std::thread::hardware_concurrency());
+    if (workers > books.size()) workers = (unsigned)std::max<size_t>(1, books.size());
+
+    std::cout << "[batch] " << books.size() << " books, " << workers << " workers → "
+              << out_dir.string() << "\n";
+
+    // 사전은 워커 시작 전에 한 번만
+    preload_dictionaries();
+    std::optional<BookCache> cache;
+    if (opt.use_cache) cache.emplace(BookCache::Options{ exe_dir() / "book_cache" });
+    std::atomic<size_t> cache_hits{0};
+
+    std::atomic<size_t> next{0};
+    std::atomic<int> failed{0};
+    // 코퍼스 합집합은 문자열 대신 사전 id 로
+    std::mutex merge_mu;
+    std::vector<uint8_t> corpus(dictionary_size(), 0);
+
+    auto worker = [&]() {
+        for (;;) {
+            const size_t i = next.fetch_add(1);
+            if (i >= books.size()) break;
+            const fs::path& book = books[i];
+            const auto tb = Clock::now();
+            try {
+                // 내용 해시로 캐시 조회 → 없으면 추출 후 저장
+                BookCache::Key key;
+                BookCache::Entry cached;
+                bool hit = false;
+                if (cache) {
+                    key = BookCache::key_for(book, BookCache::Mode::kStream);
+                    hit = cache->get(key, cached);
+                }
+                WordStream ws;
+                if (!hit) {
+                    extract_epub_text_stream(book.string(), [&](const char* data, size_t n, size_t spine_index) {
+                        ws.begin_chapter((uint32_t)spine_index);
+                        ws.feed(data, n);
+                    }, opt.jobs_per_book);
+                    ws.finish();
+                    if (cache) cache->put(key, ws.stats());
+                } else {
+                    ++cache_hits;
+                }
+                const WordStats& stats = hit ? cached.stats : ws.stats();
+
+                // 같은 이름의 책이 여러 폴더에 있을 수 있으므로 목록 순번을 붙인다
+                std::ostringstream name;
+                name << std::setw(4) << std::setfill('0') << i << "_" << book.stem().string();
+                int count = write_vocab_file(out_dir / (name.str() + ".vocab.txt"), sorted_words(stats));
+                write_stats_file(out_dir / (name.str() + ".stats.tsv"), stats);
+
+                {
+                    std::lock_guard<std::mutex> lk(merge_mu);
+                    for (uint32_t id : stats.ids) corpus[id] = 1;
+                }
+
+                std::ostringstream line;
+                line << "[ok] " << book.filename().string() << ": " << count << " words ("
+                     << (hit ? "cached, " : "") << std::fixed << std::setprecision(1)
+                     << std::chrono::duration<double, std::milli>(Clock::now() - tb).count() << " ms)\n";
+                std::cout << line.str() << std::flush;
+            } catch (const std::exception& e) {
+                ++failed;
+                std::ostringstream line;
+                line << "[warn] " << book.string() << ": " << e.what() << "\n";
+                std::cerr << line.str() << std::flush;
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(workers);
+    for (unsigned w = 0; w < workers; ++w) pool.emplace_back(worker);
+    for (auto& t : pool) t.join();
+
+    // 코퍼스 합집합
+    const fs::path corpus_vocab = out_dir / "corpus_vocab.txt";
+    std::vector<std::string> corpus_words;
+    for (uint32_t id = 0; id < corpus.size(); ++id)
+        if (corpus[id]) corpus_words.emplace_back(dictionary_word(id));
+    int corpus_count = write_vocab_file(corpus_vocab, std::move(corpus_words));
+    std::cout << "[batch] corpus vocab: " << corpus_count << " words → " << corpus_vocab.string() << "\n";
+
+    // 파이썬 레마타이저는 코퍼스 전체에 대해 한 번만
+    if (opt.lemmatize) {
+        lemmatize_vocab(exe_dir(), corpus_vocab, out_dir / "corpus_vocab_lemma.txt");
+    }
+
+    const double sec = std::chrono::duration<double>(Clock::now() - t0).count();
+    const size_t done = books.size() - (size_t)failed.load();
+    std::cout << std::fixed << std::setprecision(1)
+              << "[batch] done: " << done << "/" << books.size() << " books in " << sec << " s ("
+              << (sec > 0 ? done * 60.0 / sec : 0.0) << " books/min, " << cache_hits.load() << " from cache)\n";
+
+    return failed.load();
+}
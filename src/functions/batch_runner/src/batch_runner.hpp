@@ -0,0 +1,24 @@
+#pragma once
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// 배치(코퍼스) 모드 옵션
+struct BatchOptions {
+    std::filesystem::path out_dir;   // 결과 폴더 (비어 있으면 exe 옆 batch/)
+    unsigned workers = 0;            // 동시에 처리할 책 수 (0=코어 수)
+    unsigned jobs_per_book = 1;      // 책 하나 안에서 챕터 병렬 워커 수
+    bool lemmatize = true;           // 코퍼스 vocab 에 레마타이저 1회 실행
+    bool use_cache = true;           // 책 결과 캐시 (<exe>/book_cache, 내용이 같은 책은 추출 생략)
+};
+
+// 디렉토리(하위 포함 *.epub) 또는 파일 목록(줄당 경로 1개)에서 EPUB 경로 수집
+// 오류 시 예외(std::runtime_error) 발생
+std::vector<std::filesystem::path> collect_epubs(const std::filesystem::path& dir_or_list);
+
+// 사전을 한 번만 로드하고 책들을 워커 풀에 나눠 처리
+// - 책마다 <out_dir>/<NNNN>_<stem>.vocab.txt + .stats.tsv
+// - 바이트가 그대로인 책은 결과 캐시에서 바로 (zip/XML/토크나이저 생략)
+// - 전체 합집합 <out_dir>/corpus_vocab.txt (+ corpus_vocab_lemma.txt)
+// return: 실패한 책 수 (0=모두 성공)
+int run_batch(const std::vector<std::filesystem::path>& books, const BatchOptions& opt);
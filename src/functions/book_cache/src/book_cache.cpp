@@ -0,0 +1,240 @@
+#include "book_cache.hpp"
+#include "mmap_file.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const char     kMagic[8] = { 'E','2','V','B','O','O','K','\0' };
+// 추출 규칙(토크나이저 필터, XHTML 텍스트 규칙, 통계 열)이 바뀌면 올릴 것 → 예전 결과는 전부 미스
+const uint32_t kVersion  = 1;
+
+struct Header {
+    char     magic[8];
+    uint32_t version;
+    uint32_t mode;
+    uint64_t epub_hash;
+    uint64_t epub_size;
+    uint64_t dict_fingerprint;
+    uint64_t words;
+    uint64_t marks;
+    uint64_t text_size;
+    uint64_t check;
+};
+static_assert(sizeof(Header) == 72, "unexpected Header padding");
+
+constexpr uint64_t kP1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t kP2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t kP3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t kP4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t kP5 = 0x27D4EB2F165667C5ULL;
+
+inline uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+inline uint64_t load64(const unsigned char* p) { uint64_t v; std::memcpy(&v, p, 8); return v; }
+inline uint64_t mix(uint64_t acc, uint64_t w) { return rotl(acc + w * kP2, 31) * kP1; }
+
+// 배열을 그대로 이어 붙이기 / 읽기 (읽기는 경계 검사 포함)
+template <class T>
+void put_array(std::string& buf, const std::vector<T>& v) {
+    buf.append(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(T));
+}
+
+template <class T>
+bool get_array(const char*& p, const char* end, std::vector<T>& v, size_t n) {
+    if (size_t(end - p) / sizeof(T) < n) return false;
+    v.resize(n);
+    std::memcpy(v.data(), p, n * sizeof(T));
+    p += n * sizeof(T);
+    return true;
+}
+
+std::string hex16(uint64_t v) {
+    std::ostringstream s;
+    s << std::hex << std::setw(16) << std::setfill('0') << v;
+    return s.str();
+}
+
+} // namespace
+
+uint64_t content_hash(const void* data, size_t n, uint64_t seed) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    const uint64_t len = n;
+    uint64_t h;
+    if (n >= 32) {
+        uint64_t v1 = seed + kP1 + kP2, v2 = seed + kP2, v3 = seed, v4 = seed - kP1;
+        for (; n >= 32; p += 32, n -= 32) {
+            v1 = mix(v1, load64(p));
+            v2 = mix(v2, load64(p + 8));
+            v3 = mix(v3, load64(p + 16));
+            v4 = mix(v4, load64(p + 24));
+        }
+        h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+        for (uint64_t v : { v1, v2, v3, v4 }) h = (h ^ mix(0, v)) * kP1 + kP4;
+    } else {
+        h = seed + kP5;
+    }
+    h += len;
+    for (; n >= 8; p += 8, n -= 8) h = rotl(h ^ mix(0, load64(p)), 27) * kP1 + kP4;
+    for (; n > 0; ++p, --n) h = rotl(h ^ (*p * kP5), 11) * kP1;
+    h ^= h >> 33; h *= kP2;
+    h ^= h >> 29; h *= kP3;
+    h ^= h >> 32;
+    return h;
+}
+
+BookCache::BookCache(Options opt) : opt_(std::move(opt)) {
+    const std::string_view dict = dictionary_image();
+    const std::string_view stop = stopword_image();
+    dict_fingerprint_ = content_hash(stop.data(), stop.size(), content_hash(dict.data(), dict.size()));
+}
+
+BookCache::Key BookCache::key_for(const fs::path& epub, Mode mode) {
+    const MappedFile map(epub);
+    Key k;
+    k.epub_hash = content_hash(map.data(), map.size());
+    k.epub_size = map.size();
+    k.mode = mode;
+    return k;
+}
+
+fs::path BookCache::path_for(const Key& key) const {
+    return opt_.dir / (hex16(key.epub_hash) + "." + char(key.mode) + ".e2vc");
+}
+
+bool BookCache::get(const Key& key, Entry& out) {
+    const fs::path path = path_for(key);
+    std::error_code ec;
+    if (!fs::exists(path, ec)) return false;
+    try {
+        const MappedFile map(path);
+        Header h;
+        if (map.size() < sizeof(Header)) return false;
+        std::memcpy(&h, map.data(), sizeof(h));
+        if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0 || h.version != kVersion) return false;
+        if (h.mode != uint32_t(key.mode) || h.epub_hash != key.epub_hash || h.epub_size != key.epub_size) return false;
+        if (h.dict_fingerprint != dict_fingerprint_) return false;   // 사전이 바뀜 → 다시 추출
+
+        const char* p = map.data() + sizeof(Header);
+        const char* const end = map.data() + map.size();
+        if (content_hash(p, size_t(end - p)) != h.check) {
+            std::cerr << "[warn] book cache: corrupt " << path.string() << " — ignoring\n";
+            return false;
+        }
+
+        Entry e;
+        WordStats& s = e.stats;
+        std::vector<uint64_t> mark_offset;
+        std::vector<uint32_t> mark_spine;
+        const size_t words = (size_t)h.words, marks = (size_t)h.marks;
+        const bool ok = get_array(p, end, s.first_offset, words)
+            && get_array(p, end, s.ids, words) && get_array(p, end, s.counts, words)
+            && get_array(p, end, s.first_chapter, words) && get_array(p, end, s.chapters, words)
+            && get_array(p, end, s.last_chapter, words)
+            && get_array(p, end, mark_offset, marks) && get_array(p, end, mark_spine, marks)
+            && size_t(end - p) == h.text_size;
+        if (!ok) return false;
+        // 사전 id 가 지금 사전 범위 밖이면 (지문 충돌 등) 쓰지 않는다
+        const size_t dict_size = dictionary_size();
+        for (uint32_t id : s.ids)
+            if (id >= dict_size) return false;
+
+        e.chapters.reserve(marks);
+        for (size_t i = 0; i < marks; ++i) e.chapters.emplace_back((size_t)mark_offset[i], mark_spine[i]);
+        e.text.assign(p, end);
+        out = std::move(e);
+    } catch (const std::exception& ex) {
+        std::cerr << "[warn] book cache: " << path.string() << ": " << ex.what() << "\n";
+        return false;
+    }
+
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);   // 최근 사용 표시 (축출 순서)
+    return true;
+}
+
+void BookCache::put(const Key& key, const WordStats& stats, const ChapterMarks* chapters, const std::string* text) {
+    std::vector<uint64_t> mark_offset;
+    std::vector<uint32_t> mark_spine;
+    if (chapters) {
+        for (const auto& [off, spine] : *chapters) {
+            mark_offset.push_back(off);
+            mark_spine.push_back(spine);
+        }
+    }
+
+    std::string buf(sizeof(Header), '\0');
+    put_array(buf, stats.first_offset);
+    put_array(buf, stats.ids);
+    put_array(buf, stats.counts);
+    put_array(buf, stats.first_chapter);
+    put_array(buf, stats.chapters);
+    put_array(buf, stats.last_chapter);
+    put_array(buf, mark_offset);
+    put_array(buf, mark_spine);
+    if (text) buf += *text;
+
+    Header h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = kVersion;
+    h.mode = uint32_t(key.mode);
+    h.epub_hash = key.epub_hash;
+    h.epub_size = key.epub_size;
+    h.dict_fingerprint = dict_fingerprint_;
+    h.words = stats.size();
+    h.marks = mark_offset.size();
+    h.text_size = text ? text->size() : 0;
+    h.check = content_hash(buf.data() + sizeof(Header), buf.size() - sizeof(Header));
+    std::memcpy(&buf[0], &h, sizeof(h));
+
+    std::lock_guard<std::mutex> lk(mu_);
+    const fs::path path = path_for(key);
+    fs::path tmp = path;
+    tmp += ".tmp";
+    try {
+        fs::create_directories(opt_.dir);
+        {
+            std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+            if (!out) throw std::runtime_error("failed to create: " + tmp.string());
+            out.write(buf.data(), (std::streamsize)buf.size());
+            if (!out) throw std::runtime_error("failed to write: " + tmp.string());
+        }
+        fs::rename(tmp, path);
+    } catch (const std::exception& e) {
+        std::error_code ec;
+        fs::remove(tmp, ec);
+        std::cerr << "[warn] book cache: " << e.what() << "\n";
+        return;
+    }
+    evict();
+}
+
+// mu_ 잡은 상태에서 호출
+void BookCache::evict() {
+    if (opt_.max_bytes == 0) return;
+    struct File { fs::file_time_type used; uint64_t size; fs::path path; };
+    std::vector<File> files;
+    uint64_t total = 0;
+    std::error_code ec;
+    for (const auto& e : fs::directory_iterator(opt_.dir, ec)) {
+        if (e.path().extension() != ".e2vc") continue;
+        File f{ e.last_write_time(ec), e.file_size(ec), e.path() };
+        if (ec) { ec.clear(); continue; }
+        total += f.size;
+        files.push_back(std::move(f));
+    }
+    if (total <= opt_.max_bytes) return;
+
+    std::sort(files.begin(), files.end(), [](const File& a, const File& b) { return a.used < b.used; });
+    for (const auto& f : files) {
+        if (total <= opt_.max_bytes) break;
+        if (fs::remove(f.path, ec)) total -= f.size;
+    }
+}
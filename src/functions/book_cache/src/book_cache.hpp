@@ -0,0 +1,69 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+
+#include "../../word_extractor/src/word_extractor.hpp"
+
+// 책 하나의 단어 추출 결과 캐시 (밤마다 바뀌지 않은 책을 다시 돌릴 때 zip/XML/토크나이저를 통째로 건너뜀)
+//
+// 키 = EPUB 내용 해시 (경로/수정 시각이 아니라 바이트) + 모드 → 파일 <dir>/<해시 16진수>.<s|t>.e2vc
+//   헤더의 사전 지문(words/stopwords 이미지 해시)이나 형식 버전이 지금과 다르면 미스 → 다시 추출해서 덮어씀
+//   (words.txt / stopwords.txt 를 고치면 로드할 때 이미지가 다시 만들어지므로 지문도 바뀐다)
+// 모드: s = 스트리밍 (오프셋이 챕터 원문 기준, 통계만)
+//       t = 전체 텍스트 (squish 후 오프셋, 텍스트와 챕터 시작 위치도 저장 → book_text.txt 를 다시 쓸 수 있게)
+//
+// 레이아웃 (리틀 엔디언)
+//   Header : magic, version, mode, epub_hash, epub_size, dict_fingerprint, words, marks, text_size, check
+//   uint64 first_offset[words]
+//   uint32 ids[words], counts[words], first_chapter[words], chapters[words], last_chapter[words]
+//   uint64 mark_offset[marks], uint32 mark_spine[marks]
+//   char   text[text_size]
+// check = 헤더 뒤 전체의 content_hash (쓰다 만 파일/깨진 파일은 미스)
+// 디렉토리 전체가 max_bytes 를 넘으면 오래 안 쓴(mtime) 파일부터 지운다. 적중하면 mtime 을 갱신.
+// 파일 오류는 경고만 하고 캐시 없이 동작한다. get/put 은 스레드 안전 (배치 워커가 같이 씀)
+class BookCache {
+public:
+    enum class Mode : uint32_t { kStream = 's', kText = 't' };
+
+    struct Options {
+        std::filesystem::path dir;
+        uint64_t max_bytes = 512ULL << 20;
+    };
+    struct Key {
+        uint64_t epub_hash = 0;
+        uint64_t epub_size = 0;
+        Mode mode = Mode::kStream;
+    };
+    struct Entry {
+        WordStats stats;
+        ChapterMarks chapters;   // 모드 t 만
+        std::string text;        // 모드 t 만 (squish 된 책 전체 텍스트)
+    };
+
+    // 사전을 로드해 지문을 계산해 둔다 (아직 안 읽었으면 여기서 words/stopwords 로드)
+    explicit BookCache(Options opt);
+
+    // EPUB 을 mmap 해서 내용 해시. 열 수 없으면 예외(std::runtime_error)
+    static Key key_for(const std::filesystem::path& epub, Mode mode);
+
+    // 있고 지금 사전/형식과 맞으면 out 을 채우고 true
+    bool get(const Key& key, Entry& out);
+    // 추출 결과 저장 (모드 t 면 chapters, text 도)
+    void put(const Key& key, const WordStats& stats, const ChapterMarks* chapters = nullptr,
+             const std::string* text = nullptr);
+
+    std::filesystem::path path_for(const Key& key) const;
+
+private:
+    void evict();
+
+    Options opt_;
+    uint64_t dict_fingerprint_ = 0;
+    std::mutex mu_;   // put/evict (같은 내용의 책이 두 번 들어와도 임시 파일이 겹치지 않게)
+};
+
+// 빠른 64비트 내용 해시 (xxHash64 와 같은 구조의 4 lane 곱셈/회전 섞기, 비암호학적)
+uint64_t content_hash(const void* data, size_t n, uint64_t seed = 0);
@@ -1,7 +1,6 @@
 #include <curl/curl.h>
 #include <string>
 #include <iostream>
-#include <nlohmann/json.hpp>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -9,8 +8,18 @@
 #include <fstream>
 #include <sstream>
 #include <unordered_map>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
 #include <stdexcept>  // std::runtime_error
 #include "connect_dictionary.hpp"
+#include "definition_cache.hpp"
+#include "dictionary_backend.hpp"
+#include "dictionary_response.hpp"
+#include "http_multi.hpp"
+#include "offline_dictionary.hpp"
+#include "request_scheduler.hpp"
 
 
 #include <filesystem>
@@ -47,23 +56,14 @@ std::unordered_map<std::string,std::string> load_env(const std::string& path) {
     return env;
 }
 
-size_t write_cb(void* ptr, size_t size, size_t nmemb, std::string* data) {
-    data->append((char*)ptr, size*nmemb);
-    return size*nmemb;
-}
+static HttpMulti& http_engine();
 
+// 단건 GET (연결/DNS/TLS 세션은 http_engine 과 공유). 전송 실패나 2xx 가 아니면 예외
 std::string custom_get(std::string url) {
-    curl_global_init(CURL_GLOBAL_DEFAULT);
-    CURL* curl = curl_easy_init();
-    std::string response;
-    if (curl) {
-        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_cb);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
-        curl_easy_perform(curl);
-        curl_easy_cleanup(curl);
-    }
-    return response;
+    HttpMulti::Result r = http_engine().get(url);
+    if (!r.error.empty()) throw std::runtime_error("GET " + url + " failed: " + r.error);
+    if (!r.ok()) throw std::runtime_error("GET " + url + " failed: HTTP " + std::to_string(r.status));
+    return std::move(r.body);
 }
 
 
@@ -79,79 +79,247 @@ void save_to_file(const std::string& path, const std::string& content) {
 std::filesystem::path envPath = exe_dir() / ".env";
 auto env = load_env(envPath.u8string()); // 프로젝트 루트 기준 상대경로
 std::string DICTIONARY_KEY = env["DICTIONARY_KEY"];
+// 테스트/프록시용으로 .env 의 DICTIONARY_API_URL 로 바꿀 수 있음 (끝에 단어가 붙는다)
+std::string DICTIONARY_API_URL = env.count("DICTIONARY_API_URL") ? env["DICTIONARY_API_URL"]
+    : "https://www.dictionaryapi.com/api/v3/references/collegiate/json/";
+
+// .env 의 숫자 설정값 (없거나 잘못되면 기본값)
+static double env_number(const char* key, double fallback) {
+    auto it = env.find(key);
+    if (it == env.end() || it->second.empty()) return fallback;
+    try { return std::stod(it->second); } catch (...) { return fallback; }
+}
 
-// 주어진 단어의 짧은 정의(shortdef)를 가져와서 출력 + 품사(fl)
-std::string print_definition(const std::string& word) {
-    if (DICTIONARY_KEY.empty()) {
-        std::cerr << "Error: DICTIONARY_KEY is not set in .env file.\n";
-        return std::string("No DICTIONARY_KEY provided.");
-    }
-    std::cout << "Looking up: " << word << "\n";
+// exe 옆 definition_cache.log (DEFINITION_CACHE_TTL_DAYS, DEFINITION_CACHE_MAX_MB 로 조정)
+static DefinitionCache& definition_cache() {
+    static DefinitionCache cache([] {
+        DefinitionCache::Options opt;
+        opt.path = exe_dir() / "definition_cache.log";
+        opt.ttl_seconds = (int64_t)(env_number("DEFINITION_CACHE_TTL_DAYS", 30) * 24 * 3600);
+        opt.max_bytes = (uint64_t)(env_number("DEFINITION_CACHE_MAX_MB", 64) * 1024 * 1024);
+        return opt;
+    }());
+    return cache;
+}
 
-    std::string url = "https://www.dictionaryapi.com/api/v3/references/collegiate/json/"
-                      + word + "?key=" + DICTIONARY_KEY;
+// 정의가 없던 단어(빈 결과, "Did you mean" 제안 목록)를 따로 기억하는 캐시: exe 옆 miss_cache.log
+// 값 = 제안 목록을 '\n' 으로 이은 것 (빈 문자열 = 정의 없음). 사전이 바뀌면 풀릴 수 있으니 TTL 을 짧게
+// (DICTIONARY_MISS_TTL_DAYS, 기본 7 / DICTIONARY_MISS_CACHE_MAX_MB, 기본 8)
+static DefinitionCache& miss_cache() {
+    static DefinitionCache cache([] {
+        DefinitionCache::Options opt;
+        opt.path = exe_dir() / "miss_cache.log";
+        opt.ttl_seconds = (int64_t)(env_number("DICTIONARY_MISS_TTL_DAYS", 7) * 24 * 3600);
+        opt.max_bytes = (uint64_t)(env_number("DICTIONARY_MISS_CACHE_MAX_MB", 8) * 1024 * 1024);
+        return opt;
+    }());
+    return cache;
+}
 
-    // std::cout << "Request URL: " << url << "\n";
+// 사전 API 요청용 curl_multi 엔진 (DICTIONARY_MAX_IN_FLIGHT: 동시 요청 수, 기본 4 / DICTIONARY_TIMEOUT_S: 요청 하나당 시간 제한, 기본 15)
+static HttpMulti& http_engine() {
+    static HttpMulti engine([] {
+        HttpMulti::Options opt;
+        opt.max_in_flight = (size_t)std::max(1.0, env_number("DICTIONARY_MAX_IN_FLIGHT", 4));
+        opt.timeout_ms = (long)(env_number("DICTIONARY_TIMEOUT_S", 15) * 1000);
+        return opt;
+    }());
+    return engine;
+}
 
-    std::string raw = custom_get(url);
-    nlohmann::json j = nlohmann::json::parse(raw);
-    // std::cout << j.dump(2) << "\n";
+// API 쿼터에 맞춘 속도 제한 + 재시도 (request_scheduler.hpp)
+// DICTIONARY_RATE_PER_SEC(기본 10), DICTIONARY_BURST(기본 5), DICTIONARY_MAX_RETRIES(기본 4),
+// DICTIONARY_BATCH_BUDGET_S: 한 배치 전체 시한 (기본 120, 0 이면 없음)
+static RequestScheduler& request_scheduler() {
+    static RequestScheduler scheduler(http_engine(), [] {
+        RequestScheduler::Options opt;
+        opt.rate_per_sec = env_number("DICTIONARY_RATE_PER_SEC", 10);
+        opt.burst = env_number("DICTIONARY_BURST", 5);
+        opt.max_retries = (int)env_number("DICTIONARY_MAX_RETRIES", 4);
+        opt.batch_budget_ms = (long)(env_number("DICTIONARY_BATCH_BUDGET_S", 120) * 1000);
+        return opt;
+    }());
+    return scheduler;
+}
 
-    if (!j.is_array() || j.empty()) {
+// 응답을 가져올 곳 (DICTIONARY_BACKEND=http|offline|auto, 기본 auto)
+// auto 는 exe 옆에 dictionary.bin/.jsonl 이 있으면 offline, 없으면 http
+static DictionaryBackend& dictionary_backend() {
+    static const std::unique_ptr<DictionaryBackend> backend = [] {
+        const std::string want = env.count("DICTIONARY_BACKEND") ? env["DICTIONARY_BACKEND"] : "auto";
+        std::unique_ptr<DictionaryBackend> b;
+        if (want != "http") {
+            if (const OfflineDictionary* dict = default_offline_dictionary()) b = make_offline_backend(*dict);
+            else if (want == "offline")
+                std::cerr << "[warn] DICTIONARY_BACKEND=offline but dictionary.jsonl/.bin not found — using http\n";
+        }
+        if (!b) b = make_http_backend(request_scheduler(), DICTIONARY_API_URL, DICTIONARY_KEY);
+        std::cout << "[info] dictionary backend: " << b->name() << "\n";
+        return b;
+    }();
+    return *backend;
+}
+
+static std::string cache_key(const std::string& word) {
+    std::string k = word;
+    for (auto& c : k) c = (char)std::tolower((unsigned char)c);
+    return k;
+}
+
+void print_definition_cache_stats() {
+    const auto st = definition_cache().stats();
+    std::cout << "[cache] definitions: " << st.hits << " hits, " << st.misses << " misses";
+    if (st.expired) std::cout << " (" << st.expired << " expired)";
+    std::cout << ", " << st.stores << " stored, " << st.evictions << " evicted, "
+              << definition_cache().size() << " entries / "
+              << definition_cache().file_bytes() / 1024 << " KB\n";
+    if (dictionary_backend().remote()) {
+        const auto ms = miss_cache().stats();
+        std::cout << "[cache] known misses: " << ms.hits << " skipped or served, " << ms.stores << " stored, "
+                  << miss_cache().size() << " entries\n";
+        const auto rs = request_scheduler().stats();
+        if (rs.sent) {
+            std::cout << "[http] dictionary requests: " << rs.sent << " sent, " << rs.retries << " retried, "
+                      << rs.throttled << " throttled (429), " << rs.failed << " failed";
+            if (rs.expired) std::cout << " (" << rs.expired << " past batch budget)";
+            std::cout << "\n";
+        }
+    }
+}
+
+// 정의가 없는 응답: 빈 결과 또는 자동완성 제안(문자열 배열). 미스 캐시 적중도 같은 출력
+static std::string format_miss(const std::string& word, const std::vector<std::string>& suggestions) {
+    if (suggestions.empty()) {
         std::cout << "No definitions found for \"" << word << "\"\n";
         return std::string("No definitions found.");
     }
+    std::cout << "Did you mean:\n";
+    for (const auto& s : suggestions) std::cout << " - " << s << "\n";
+    return std::string("No exact match found. Suggestions provided.");
+}
 
-    std::string response;
-
-    // 자동완성 제안(문자열 배열) 대응
-    bool all_strings = true;
-    for (const auto& e : j) { if (!e.is_string()) { all_strings = false; break; } }
-    if (all_strings) {
-        std::cout << "Did you mean:\n";
-        for (const auto& s : j) std::cout << " - " << s.get<std::string>() << "\n";
-        return std::string("No exact match found. Suggestions provided.");
+static std::string join_lines(const std::vector<std::string>& lines) {
+    std::string out;
+    for (const auto& l : lines) {
+        if (!out.empty()) out += '\n';
+        out += l;
     }
+    return out;
+}
 
-    // Merriam-Webster는 하나의 단어에 여러 entry가 있을 수 있음
-    for (size_t i = 0; i < j.size(); ++i) {
-        if (i >= 3) { // 최대 3개 세트만 출력
-            std::cout << "... (more definitions available)\n";
-            break;
-        }
-        const auto& entry = j[i];
-        if (!entry.is_object() || !entry.contains("shortdef")) continue;
-
-        // 품사(fl)와 표제어(hwi.hw) 추출
-        std::string pos;
-        if (entry.contains("fl") && entry["fl"].is_string()) pos = entry["fl"].get<std::string>();
+static std::vector<std::string> split_lines(const std::string& s) {
+    std::vector<std::string> out;
+    std::istringstream in(s);
+    for (std::string l; std::getline(in, l);) out.push_back(l);
+    return out;
+}
 
-        std::string headword;
-        if (entry.contains("hwi") && entry["hwi"].is_object()
-            && entry["hwi"].contains("hw") && entry["hwi"]["hw"].is_string()) {
-            headword = entry["hwi"]["hw"].get<std::string>();
-        };
+// API 응답(parse_dictionary_response 로 필요한 필드만 SAX 로 읽은 것)에서 짧은 정의(shortdef) + 품사(fl) 를 출력용 문자열로
+static std::string format_definition(const std::string& word, const DictionaryResponse& r) {
+    if (r.kind != DictionaryResponse::kEntries) return format_miss(word, r.suggestions);
 
-        if (i == 0) {
+    // Merriam-Webster는 하나의 단어에 여러 entry가 있을 수 있음 (최대 3개 세트만)
+    std::string response;
+    for (const auto& entry : r.entries) {
+        if (entry.index == 0) {
             response += "Target Word: " + word + "\n";
         };
-        response += "Definition Set " + std::to_string(i + 1) + ":\n";
-        response += "Headword: " + headword + "\n";
-        response += "Part of Speech: " + pos + "\n";
+        response += "Definition Set " + std::to_string(entry.index + 1) + ":\n";
+        response += "Headword: " + entry.headword + "\n";
+        response += "Part of Speech: " + entry.pos + "\n";
         response += "Definitions:\n";
-        for (const auto& def : entry["shortdef"]) {
-            if (def.is_string()) response += " - " + def.get<std::string>() + "\n";
+        for (const auto& def : entry.defs) response += " - " + def + "\n";
+    }
+    if (r.more) std::cout << "... (more definitions available)\n";
+    return response;
+}
+
+bool known_miss(const std::string& word) {
+    if (!dictionary_backend().remote()) return false;
+    std::string ignored;
+    return miss_cache().get(cache_key(word), ignored);
+}
+
+// 한 단어 비동기 조회: 캐시 적중/키 없음/오프라인 사전은 done 을 바로 부르고 0, 아니면 요청을 예약하고 취소용 번호
+// done 은 poll_definitions() 를 부른 스레드에서 호출된다. 원격 응답은 정의를 찾았으면 정의 캐시에,
+// 정의가 없으면(빈 결과/제안 목록) 미스 캐시에 저장
+// 조회 실패(재시도 소진, 시한 초과, 읽을 수 없는 응답)는 실행을 멈추지 않고 "Lookup failed" 정의로 넘긴다 (캐시 안 함)
+uint64_t request_definition(const std::string& word, DefinitionCallback done) {
+    DictionaryBackend& backend = dictionary_backend();
+    const bool remote = backend.remote();
+    if (remote) {
+        std::string cached;
+        if (definition_cache().get(cache_key(word), cached)) {
+            std::cout << "Cached: " << word << "\n";
+            done(std::move(cached));
+            return 0;
+        }
+        if (miss_cache().get(cache_key(word), cached)) {
+            std::cout << "Cached miss: " << word << "\n";
+            done(format_miss(word, split_lines(cached)));
+            return 0;
         }
+        if (DICTIONARY_KEY.empty()) {
+            std::cerr << "Error: DICTIONARY_KEY is not set in .env file.\n";
+            done("No DICTIONARY_KEY provided.");
+            return 0;
+        }
+    }
 
-        // std::cout << "---- Definition Set " << (i + 1) << " ----\n";
-        // if (!headword.empty()) std::cout << "Headword: " << headword << "\n";
-        // if (!pos.empty())      std::cout << "Part of Speech: " << pos << "\n";
+    std::cout << "Looking up: " << word << "\n";
+    return backend.fetch(word, [word, remote, done = std::move(done)](std::string raw, std::exception_ptr error) {
+        std::string def;
+        try {
+            if (error) std::rethrow_exception(error);
+            const DictionaryResponse r = parse_dictionary_response(raw);
+            def = format_definition(word, r);
+            if (remote && r.kind == DictionaryResponse::kEntries && !def.empty()) definition_cache().put(cache_key(word), def);
+            else if (remote && r.kind != DictionaryResponse::kEntries) miss_cache().put(cache_key(word), join_lines(r.suggestions));
+        } catch (const std::exception& e) {
+            std::cerr << "[warn] lookup failed for \"" << word << "\": " << e.what() << "\n";
+            def = std::string("Lookup failed: ") + e.what();
+        }
+        done(std::move(def));
+    });
+}
+
+bool cancel_definition(uint64_t ticket) {
+    return ticket != 0 && dictionary_backend().cancel(ticket);
+}
 
-        // for (const auto& def : entry["shortdef"]) {
-        //     if (def.is_string()) std::cout << "- " << def.get<std::string>() << "\n";
-        // }
+size_t poll_definitions(int timeout_ms) {
+    return dictionary_backend().poll(timeout_ms);
+}
+
+// 여러 단어를 한 번에: 캐시 적중은 바로 채우고, 나머지는 동시에 요청 (결과는 입력 순서)
+std::vector<std::string> print_definitions(const std::vector<std::string>& words, size_t max_in_flight) {
+    std::vector<std::string> out(words.size());
+    std::mutex mu;                              // 콜백은 poll 을 부른 다른 스레드에서 올 수도 있음
+    std::atomic<size_t> left{ words.size() };
+    for (size_t i = 0; i < words.size(); ++i) {
+        request_definition(words[i], [&, i](std::string def) {
+            {
+                std::lock_guard<std::mutex> lk(mu);
+                out[i] = std::move(def);
+            }
+            --left;
+        });
     }
-    return response;
+
+    HttpMulti& http = http_engine();
+    const size_t saved_limit = http.max_in_flight();
+    if (max_in_flight) http.set_max_in_flight(max_in_flight);
+    while (left.load() > 0) poll_definitions(100);
+    http.set_max_in_flight(saved_limit);
+
+    std::lock_guard<std::mutex> lk(mu);
+    return out;
+}
+
+// 주어진 단어의 짧은 정의(shortdef)를 가져와서 출력 + 품사(fl)
+// 캐시에 있으면 네트워크 없이 바로 반환
+std::string print_definition(const std::string& word) {
+    return print_definitions({ word }).front();
 }
 
 
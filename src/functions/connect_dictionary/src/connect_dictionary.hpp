@@ -1,9 +1,31 @@
 #pragma once
+#include <cstdint>
 #include <filesystem>
+#include <functional>
 #include <string>
+#include <vector>
 
 // exe 옆의 vocab.txt를 받아서 py/lemmatize_list.py 실행 → vocab_lemma.txt 생성
 // return: 프로세스 종료코드(0=성공)
 int connect_dictionary(std::string word);
 void save_to_file(const std::string& path, const std::string& content);
-std::string print_definition(const std::string &word);
\ No newline at end of file
+std::string print_definition(const std::string &word);
+// 여러 단어 정의를 동시 요청으로 한 번에 (결과는 words 순서, max_in_flight 0 = .env 기본값)
+std::vector<std::string> print_definitions(const std::vector<std::string>& words, size_t max_in_flight = 0);
+
+// 비동기 조회 (캐시/키 없음이면 done 을 즉시 부르고 0 반환, 아니면 취소용 번호)
+// done 은 poll_definitions 를 부르는 스레드에서 정확히 한 번 호출됨. 실패(재시도 소진, 시한 초과, 읽을 수 없는 응답)도
+// 예외가 아니라 "Lookup failed: <이유>" 정의로 전달된다 (캐시 안 함)
+using DefinitionCallback = std::function<void(std::string definition)>;
+uint64_t request_definition(const std::string& word, DefinitionCallback done);
+// 아직 끝나지 않은 조회 취소 (콜백은 불리지 않음)
+bool cancel_definition(uint64_t ticket);
+// 예약된 조회 진행 + 끝난 것 콜백. 반환: 남은 조회 수
+size_t poll_definitions(int timeout_ms);
+
+// 최근 조회에서 정의가 없다고(빈 결과/제안 목록) 확인된 단어인지 (원격 사전일 때 미스 캐시 조회)
+// 단어 뽑기에서 네트워크 왕복 전에 거르는 데 쓴다
+bool known_miss(const std::string& word);
+
+// 정의 캐시 적중/미스/저장/축출 수 출력
+void print_definition_cache_stats();
\ No newline at end of file
@@ -0,0 +1,221 @@
+#include "definition_cache.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const char kMagic[4] = { 'E','2','D','C' };
+
+struct RecordHeader {
+    char     magic[4];
+    uint32_t key_size;
+    uint32_t value_size;
+    uint32_t check;        // FNV-1a(key + value): 끝이 잘린/깨진 레코드 감지용
+    int64_t  stored_at;
+};
+static_assert(sizeof(RecordHeader) == 24, "unexpected RecordHeader padding");
+
+// 말도 안 되게 큰 길이는 깨진 레코드로 본다
+const uint32_t kMaxField = 16u << 20;
+
+uint32_t fnv1a(uint32_t h, const std::string& s) {
+    for (unsigned char c : s) h = (h ^ c) * 16777619u;
+    return h;
+}
+uint32_t record_check(const std::string& key, const std::string& value) {
+    return fnv1a(fnv1a(2166136261u, key), value);
+}
+
+int64_t unix_now() {
+    using namespace std::chrono;
+    return duration_cast<seconds>(system_clock::now().time_since_epoch()).count();
+}
+
+void write_record(std::ostream& out, const std::string& key, const std::string& value, int64_t stored_at) {
+    RecordHeader h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.key_size = (uint32_t)key.size();
+    h.value_size = (uint32_t)value.size();
+    h.check = record_check(key, value);
+    h.stored_at = stored_at;
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    out.write(key.data(), (std::streamsize)key.size());
+    out.write(value.data(), (std::streamsize)value.size());
+}
+
+} // namespace
+
+DefinitionCache::DefinitionCache(Options opt) : opt_(std::move(opt)) {
+    load();
+    open_log();
+}
+
+// 로그를 처음부터 읽어 색인을 만든다. 깨진 꼬리는 잘라 낸다(마지막 쓰기 도중 종료 등)
+void DefinitionCache::load() {
+    std::error_code ec;
+    if (!fs::exists(opt_.path, ec)) return;
+    const uint64_t file_size = fs::file_size(opt_.path, ec);
+
+    {
+        std::ifstream in(opt_.path, std::ios::binary);
+        if (!in) {
+            std::cerr << "[warn] cannot open definition cache: " << opt_.path.string() << "\n";
+            return;
+        }
+        std::string key, value;
+        while (end_ < file_size) {
+            RecordHeader h;
+            if (!in.read(reinterpret_cast<char*>(&h), sizeof(h))) break;
+            if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0
+                || h.key_size > kMaxField || h.value_size > kMaxField) break;
+            key.resize(h.key_size);
+            value.resize(h.value_size);
+            if (!in.read(key.data(), h.key_size) || !in.read(value.data(), h.value_size)) break;
+            if (record_check(key, value) != h.check) break;
+
+            index_[key] = Slot{ end_, h.key_size, h.value_size, h.stored_at };
+            end_ += sizeof(h) + h.key_size + h.value_size;
+        }
+    }
+
+    if (end_ < file_size) {
+        std::cerr << "[warn] definition cache: dropping " << (file_size - end_)
+                  << " corrupt trailing bytes\n";
+        fs::resize_file(opt_.path, end_, ec);
+        if (ec) std::cerr << "[warn] definition cache: truncate failed: " << ec.message() << "\n";
+    }
+}
+
+void DefinitionCache::open_log() {
+    if (opt_.path.has_parent_path()) {
+        std::error_code ec;
+        fs::create_directories(opt_.path.parent_path(), ec);
+    }
+    log_.open(opt_.path, std::ios::in | std::ios::out | std::ios::binary | std::ios::app);
+    if (!log_) std::cerr << "[warn] cannot open definition cache: " << opt_.path.string() << "\n";
+}
+
+bool DefinitionCache::expired(const Slot& s, int64_t now) const {
+    return opt_.ttl_seconds > 0 && now - s.stored_at >= opt_.ttl_seconds;
+}
+
+bool DefinitionCache::read_value(const Slot& s, std::string& value) {
+    if (!log_.is_open()) return false;
+    log_.clear();
+    log_.seekg((std::streamoff)(s.offset + sizeof(RecordHeader) + s.key_size));
+    value.resize(s.value_size);
+    if (!log_.read(value.data(), s.value_size)) {
+        log_.clear();
+        return false;
+    }
+    return true;
+}
+
+bool DefinitionCache::get(const std::string& key, std::string& value) {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto it = index_.find(key);
+    if (it == index_.end()) { ++stats_.misses; return false; }
+    if (expired(it->second, unix_now())) {
+        ++stats_.misses;
+        ++stats_.expired;
+        return false;
+    }
+    if (!read_value(it->second, value)) { ++stats_.misses; return false; }
+    ++stats_.hits;
+    return true;
+}
+
+void DefinitionCache::put(const std::string& key, const std::string& value) {
+    if (key.size() > kMaxField || value.size() > kMaxField) return;
+    std::lock_guard<std::mutex> lk(mu_);
+    if (!log_.is_open()) return;
+
+    const int64_t now = unix_now();
+    log_.clear();
+    log_.seekp(0, std::ios::end);
+    write_record(log_, key, value, now);
+    log_.flush();
+    if (!log_) {
+        std::cerr << "[warn] definition cache: write failed\n";
+        log_.clear();
+        return;
+    }
+    index_[key] = Slot{ end_, (uint32_t)key.size(), (uint32_t)value.size(), now };
+    end_ += sizeof(RecordHeader) + key.size() + value.size();
+    ++stats_.stores;
+
+    if (opt_.max_bytes && end_ > opt_.max_bytes) compact(now);
+}
+
+// 살아 있는 항목을 최신순으로 max_bytes 의 3/4 까지만 새 파일에 옮겨 담는다
+// (가득 찰 때마다 컴팩션하지 않도록 여유를 남김). 만료/덮어쓴 레코드는 여기서 사라진다.
+void DefinitionCache::compact(int64_t now) {
+    std::vector<std::pair<std::string, Slot>> live;
+    live.reserve(index_.size());
+    for (const auto& [k, s] : index_) {
+        if (!expired(s, now)) live.emplace_back(k, s);
+    }
+    std::sort(live.begin(), live.end(), [](const auto& a, const auto& b) {
+        return a.second.stored_at > b.second.stored_at;
+    });
+
+    const uint64_t budget = opt_.max_bytes / 4 * 3;
+    fs::path tmp = opt_.path;
+    tmp += ".tmp";
+
+    std::unordered_map<std::string, Slot> next;
+    uint64_t pos = 0;
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "[warn] definition cache: cannot create " << tmp.string() << "\n";
+            return;
+        }
+        std::string value;
+        for (const auto& [k, s] : live) {
+            const uint64_t rec = sizeof(RecordHeader) + s.key_size + s.value_size;
+            if (pos + rec > budget) { ++stats_.evictions; continue; }
+            if (!read_value(s, value)) continue;
+            write_record(out, k, value, s.stored_at);
+            next[k] = Slot{ pos, s.key_size, s.value_size, s.stored_at };
+            pos += rec;
+        }
+        if (!out) {
+            std::cerr << "[warn] definition cache: compaction write failed\n";
+            return;
+        }
+    }
+
+    log_.close();
+    std::error_code ec;
+    fs::rename(tmp, opt_.path, ec);
+    if (ec) {
+        std::cerr << "[warn] definition cache: rename failed: " << ec.message() << "\n";
+        fs::remove(tmp, ec);
+    } else {
+        index_.swap(next);
+        end_ = pos;
+    }
+    open_log();
+}
+
+DefinitionCache::Stats DefinitionCache::stats() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return stats_;
+}
+
+size_t DefinitionCache::size() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return index_.size();
+}
+
+uint64_t DefinitionCache::file_bytes() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return end_;
+}
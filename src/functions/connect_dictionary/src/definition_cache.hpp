@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// print_definition 결과를 디스크에 남겨 두는 영구 캐시 (표제어 → 정의 문자열)
+//
+// 추가 전용 로그 파일 + 메모리 색인
+//   레코드 = RecordHeader(magic, key_size, value_size, check, stored_at) + key + value
+//   같은 키를 다시 쓰면 마지막 레코드가 이긴다. 열 때 끝부분이 깨져 있으면 잘라낸다.
+// - TTL 이 지난 항목은 미스로 취급 (다음 put 때 덮어씀)
+// - 파일이 max_bytes 를 넘으면 살아 있는 최신 항목만 남기도록 다시 써서(컴팩션) 오래된 것부터 축출
+// 모든 멤버 함수는 스레드 안전(내부 mutex). 파일 오류는 경고만 하고 캐시 없이 동작한다.
+class DefinitionCache {
+public:
+    struct Options {
+        std::filesystem::path path;
+        int64_t  ttl_seconds = 30LL * 24 * 3600;   // 0 이하 = 만료 없음
+        uint64_t max_bytes   = 64ULL << 20;
+    };
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;      // 만료 포함
+        uint64_t expired = 0;
+        uint64_t stores = 0;
+        uint64_t evictions = 0;
+    };
+
+    explicit DefinitionCache(Options opt);
+
+    // 캐시에 있고 만료되지 않았으면 value 를 채우고 true
+    bool get(const std::string& key, std::string& value);
+    void put(const std::string& key, const std::string& value);
+
+    Stats stats() const;
+    size_t size() const;
+    uint64_t file_bytes() const;
+
+private:
+    struct Slot {
+        uint64_t offset;       // 레코드 시작 위치
+        uint32_t key_size;
+        uint32_t value_size;
+        int64_t  stored_at;    // unix time (초)
+    };
+
+    void load();
+    void open_log();
+    bool read_value(const Slot& s, std::string& value);
+    void compact(int64_t now);
+    bool expired(const Slot& s, int64_t now) const;
+
+    Options opt_;
+    mutable std::mutex mu_;
+    std::fstream log_;
+    uint64_t end_ = 0;         // 로그 파일 크기 (다음 레코드 위치)
+    std::unordered_map<std::string, Slot> index_;
+    Stats stats_;
+};
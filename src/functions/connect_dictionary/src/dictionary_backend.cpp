@@ -0,0 +1,64 @@
+#include "dictionary_backend.hpp"
+#include "offline_dictionary.hpp"
+#include "request_scheduler.hpp"
+
+#include <stdexcept>
+#include <string_view>
+
+namespace {
+
+class HttpBackend : public DictionaryBackend {
+public:
+    HttpBackend(RequestScheduler& http, std::string api_url, std::string api_key)
+        : http_(http), url_(std::move(api_url)), key_(std::move(api_key)) {}
+
+    const char* name() const override { return "http"; }
+    bool remote() const override { return true; }
+
+    uint64_t fetch(const std::string& word, RawCallback done) override {
+        return http_.submit(url_ + word + "?key=" + key_, [done = std::move(done)](HttpMulti::Result&& r) {
+            // 쿼터 초과/서버 오류 페이지(HTML)를 JSON 으로 읽지 않도록 여기서 걸러 오류로 넘긴다
+            if (!r.ok()) {
+                const std::string why = !r.error.empty() ? r.error : "HTTP " + std::to_string(r.status);
+                done(std::string(), std::make_exception_ptr(std::runtime_error(why)));
+                return;
+            }
+            done(std::move(r.body), nullptr);
+        });
+    }
+    bool cancel(uint64_t ticket) override { return http_.cancel(ticket); }
+    size_t poll(int timeout_ms) override { return http_.poll(timeout_ms); }
+
+private:
+    RequestScheduler& http_;
+    std::string url_;
+    std::string key_;
+};
+
+class OfflineBackend : public DictionaryBackend {
+public:
+    explicit OfflineBackend(const OfflineDictionary& dict) : dict_(dict) {}
+
+    const char* name() const override { return "offline"; }
+    bool remote() const override { return false; }
+
+    uint64_t fetch(const std::string& word, RawCallback done) override {
+        std::string_view raw;
+        if (dict_.find(word, raw)) done(std::string(raw), nullptr);
+        else done("[]", nullptr);
+        return 0;
+    }
+
+private:
+    const OfflineDictionary& dict_;
+};
+
+} // namespace
+
+std::unique_ptr<DictionaryBackend> make_http_backend(RequestScheduler& http, std::string api_url, std::string api_key) {
+    return std::make_unique<HttpBackend>(http, std::move(api_url), std::move(api_key));
+}
+
+std::unique_ptr<DictionaryBackend> make_offline_backend(const OfflineDictionary& dict) {
+    return std::make_unique<OfflineBackend>(dict);
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+
+class OfflineDictionary;
+class RequestScheduler;
+
+// 단어 → 사전 응답(raw JSON, Merriam-Webster 모양) 을 가져오는 곳
+// print_definition 쪽(캐시, 응답 해석, 출력)은 어느 구현이든 똑같이 동작한다
+//   http    : dictionaryapi.com (또는 .env 의 DICTIONARY_API_URL) 에 curl_multi 로 비동기 요청
+//             (RequestScheduler 가 속도 제한/재시도를 맡는다)
+//   offline : dictionary.bin (offline_dictionary.hpp) 을 mmap 해서 바로 조회
+class DictionaryBackend {
+public:
+    using RawCallback = std::function<void(std::string raw, std::exception_ptr error)>;
+
+    virtual ~DictionaryBackend() = default;
+
+    virtual const char* name() const = 0;
+    // 원격이면 정의 캐시에 저장할 가치가 있다
+    virtual bool remote() const = 0;
+
+    // 조회 예약. 바로 끝나면 done 을 호출하고 0, 아니면 취소용 번호 (done 은 poll 을 부른 스레드에서)
+    virtual uint64_t fetch(const std::string& word, RawCallback done) = 0;
+    // 끝나지 않은 조회 취소 (콜백은 불리지 않음)
+    virtual bool cancel(uint64_t ticket) { (void)ticket; return false; }
+    // 예약된 조회 진행. 반환: 남은 조회 수
+    virtual size_t poll(int timeout_ms) { (void)timeout_ms; return 0; }
+};
+
+// api_url 뒤에 단어와 ?key= 를 붙여 요청. 전송 실패나 2xx 가 아닌 응답은 error 로 넘긴다
+std::unique_ptr<DictionaryBackend> make_http_backend(RequestScheduler& http, std::string api_url, std::string api_key);
+// 표에 없는 단어는 빈 배열("[]") = 정의 없음
+std::unique_ptr<DictionaryBackend> make_offline_backend(const OfflineDictionary& dict);
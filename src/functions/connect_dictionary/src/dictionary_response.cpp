@@ -0,0 +1,301 @@
+#include "dictionary_response.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace {
+
+const size_t kMaxEntries = 3;   // 출력하는 entry 수 (DOM 경로와 같아야 함)
+
+// 깊이 1 = 최상위 배열 안, 2 = entry 객체 안, 3 = hwi / shortdef 안
+class ResponseSax {
+public:
+    explicit ResponseSax(DictionaryResponse& out) : out_(out) {}
+
+    bool null()                                 { return scalar(nullptr); }
+    bool boolean(bool)                          { return scalar(nullptr); }
+    bool number_integer(json::number_integer_t) { return scalar(nullptr); }
+    bool number_unsigned(json::number_unsigned_t) { return scalar(nullptr); }
+    bool number_float(json::number_float_t, const json::string_t&) { return scalar(nullptr); }
+    bool binary(json::binary_t&)                { return scalar(nullptr); }
+    bool string(json::string_t& s)              { return scalar(&s); }
+
+    bool start_object(size_t) {
+        if (depth_ == 0) return stop_none();
+        if (depth_ == 1) {
+            if (!element(false)) return false;
+            entry_ = {};
+            entry_.index = index_;
+            in_entry_ = true;
+            has_shortdef_ = false;
+        } else {
+            container();
+        }
+        ++depth_;
+        return true;
+    }
+
+    bool end_object() {
+        --depth_;
+        if (depth_ == 2) {
+            field_ = kOther;
+        } else if (depth_ == 1) {
+            if (has_shortdef_) out_.entries.push_back(std::move(entry_));
+            in_entry_ = false;
+        }
+        return true;
+    }
+
+    bool start_array(size_t) {
+        if (depth_ == 0) {
+            top_array_ = true;
+        } else if (depth_ == 1) {
+            if (!element(false)) return false;
+            in_entry_ = false;
+        } else {
+            container();
+        }
+        ++depth_;
+        return true;
+    }
+
+    bool end_array() {
+        --depth_;
+        if (depth_ == 2) field_ = kOther;
+        return true;
+    }
+
+    bool key(json::string_t& k) {
+        if (depth_ == 2) key2_.swap(k);
+        else if (depth_ == 3) key3_.swap(k);
+        return true;
+    }
+
+    // 여기서 던지면 기반 클래스로 잘려 json::parse_error 로 잡히지 않는다 → 담아 두고 멈춘 뒤 호출자가 던짐
+    bool parse_error(size_t, const std::string&, const nlohmann::detail::exception& ex) {
+        if (const auto* pe = dynamic_cast<const json::parse_error*>(&ex)) error_ = std::make_exception_ptr(*pe);
+        else error_ = std::make_exception_ptr(std::runtime_error(ex.what()));
+        return false;
+    }
+    const std::exception_ptr& error() const { return error_; }
+
+    // 파싱이 끝났거나(또는 일찍 멈춘 뒤) 결과 종류 확정
+    void finish() {
+        if (!top_array_ || count_ == 0) {
+            out_ = {};
+        } else if (all_strings_) {
+            out_.kind = DictionaryResponse::kSuggestions;
+            out_.entries.clear();
+        } else {
+            out_.kind = DictionaryResponse::kEntries;
+            out_.suggestions.clear();
+        }
+    }
+
+private:
+    enum Field { kOther, kHwi, kShortdef };
+
+    // 최상위 배열의 새 원소. 문자열이 아닌 원소가 있으면 entry 목록이고,
+    // 그때 이미 3개를 넘었으면 나머지는 볼 필요가 없다
+    bool element(bool is_string) {
+        index_ = count_++;
+        if (!is_string) all_strings_ = false;
+        if (!all_strings_ && index_ >= kMaxEntries) {
+            out_.more = true;
+            return false;
+        }
+        return true;
+    }
+
+    // entry 안의 값 (깊이 2). 같은 키가 두 번 나오면 DOM 처럼 뒤의 것이 이긴다
+    void open_field(const std::string& key) {
+        field_ = kOther;
+        if (key == "hwi") {
+            entry_.headword.clear();
+            field_ = kHwi;
+        } else if (key == "shortdef") {
+            entry_.defs.clear();
+            has_shortdef_ = true;
+            field_ = kShortdef;
+        } else if (key == "fl") {
+            entry_.pos.clear();
+        }
+    }
+
+    // 깊이 2 이상에서 시작하는 객체/배열
+    void container() {
+        if (!in_entry_) return;
+        if (depth_ == 2) open_field(key2_);
+        else if (depth_ == 3 && field_ == kHwi && key3_ == "hw") entry_.headword.clear();
+    }
+
+    bool scalar(json::string_t* s) {
+        switch (depth_) {
+        case 0:
+            return stop_none();
+        case 1:
+            if (!element(s != nullptr)) return false;
+            if (s && all_strings_) out_.suggestions.push_back(std::move(*s));
+            return true;
+        case 2:
+            if (!in_entry_) return true;
+            open_field(key2_);
+            field_ = kOther;
+            if (!s) return true;
+            if (key2_ == "fl") entry_.pos = std::move(*s);
+            else if (key2_ == "shortdef") entry_.defs.push_back(std::move(*s));
+            return true;
+        case 3:
+            if (!in_entry_) return true;
+            if (field_ == kHwi && key3_ == "hw") {
+                if (s) entry_.headword = std::move(*s);
+                else entry_.headword.clear();
+            } else if (field_ == kShortdef && s) {
+                entry_.defs.push_back(std::move(*s));
+            }
+            return true;
+        default:
+            return true;
+        }
+    }
+
+    bool stop_none() {
+        top_array_ = false;
+        return false;
+    }
+
+    DictionaryResponse& out_;
+    DictionaryResponse::Entry entry_;
+    int    depth_ = 0;
+    size_t count_ = 0;              // 지금까지 본 최상위 원소 수
+    size_t index_ = 0;              // 지금 원소의 위치
+    bool   top_array_ = false;
+    bool   all_strings_ = true;
+    bool   in_entry_ = false;        // 최상위 배열의 객체 원소 안 (깊이 2 이상)
+    bool   has_shortdef_ = false;
+    Field  field_ = kOther;
+    std::string key2_, key3_;
+    std::exception_ptr error_;
+};
+
+} // namespace
+
+bool DictionaryResponse::operator==(const DictionaryResponse& o) const {
+    if (kind != o.kind || suggestions != o.suggestions || more != o.more
+        || entries.size() != o.entries.size()) return false;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const Entry& a = entries[i];
+        const Entry& b = o.entries[i];
+        if (a.index != b.index || a.headword != b.headword || a.pos != b.pos || a.defs != b.defs)
+            return false;
+    }
+    return true;
+}
+
+DictionaryResponse parse_dictionary_response(const std::string& raw) {
+    DictionaryResponse out;
+    ResponseSax sax(out);
+    json::sax_parse(raw, &sax);
+    if (sax.error()) std::rethrow_exception(sax.error());
+    sax.finish();
+    return out;
+}
+
+DictionaryResponse parse_dictionary_response_dom(const std::string& raw) {
+    DictionaryResponse out;
+    json j = json::parse(raw);
+    if (!j.is_array() || j.empty()) return out;
+
+    bool all_strings = true;
+    for (const auto& e : j) { if (!e.is_string()) { all_strings = false; break; } }
+    if (all_strings) {
+        out.kind = DictionaryResponse::kSuggestions;
+        for (const auto& s : j) out.suggestions.push_back(s.get<std::string>());
+        return out;
+    }
+
+    out.kind = DictionaryResponse::kEntries;
+    for (size_t i = 0; i < j.size(); ++i) {
+        if (i >= kMaxEntries) { out.more = true; break; }
+        const auto& entry = j[i];
+        if (!entry.is_object() || !entry.contains("shortdef")) continue;
+
+        DictionaryResponse::Entry e;
+        e.index = i;
+        if (entry.contains("fl") && entry["fl"].is_string()) e.pos = entry["fl"].get<std::string>();
+        if (entry.contains("hwi") && entry["hwi"].is_object()
+            && entry["hwi"].contains("hw") && entry["hwi"]["hw"].is_string()) {
+            e.headword = entry["hwi"]["hw"].get<std::string>();
+        }
+        for (const auto& def : entry["shortdef"]) {
+            if (def.is_string()) e.defs.push_back(def.get<std::string>());
+        }
+        out.entries.push_back(std::move(e));
+    }
+    return out;
+}
+
+bool bench_dictionary_responses(const fs::path& dir, int repeats) {
+    std::vector<fs::path> files;
+    std::error_code ec;
+    for (const auto& de : fs::directory_iterator(dir, ec)) {
+        if (de.is_regular_file() && de.path().extension() == ".json") files.push_back(de.path());
+    }
+    std::sort(files.begin(), files.end());
+    if (files.empty()) {
+        std::cerr << "[error] no *.json fixtures in: " << dir.string() << " (see py/record_dictionary_fixtures.py)\n";
+        return false;
+    }
+
+    using clock = std::chrono::steady_clock;
+    size_t bad = 0, bytes = 0;
+    double dom_s = 0, sax_s = 0;
+    for (const auto& f : files) {
+        std::ifstream in(f, std::ios::binary);
+        std::stringstream ss;
+        ss << in.rdbuf();
+        const std::string raw = ss.str();
+        bytes += raw.size();
+
+        DictionaryResponse dom, sax;
+        try {
+            dom = parse_dictionary_response_dom(raw);
+            sax = parse_dictionary_response(raw);
+        } catch (const std::exception& e) {
+            std::cout << "    " << f.filename().string() << ": " << e.what() << "\n";
+            ++bad;
+            continue;
+        }
+        if (!(dom == sax)) {
+            std::cout << "    mismatch: " << f.filename().string() << "\n";
+            ++bad;
+            continue;
+        }
+
+        auto t0 = clock::now();
+        for (int r = 0; r < repeats; ++r) dom = parse_dictionary_response_dom(raw);
+        auto t1 = clock::now();
+        for (int r = 0; r < repeats; ++r) sax = parse_dictionary_response(raw);
+        auto t2 = clock::now();
+        dom_s += std::chrono::duration<double>(t1 - t0).count();
+        sax_s += std::chrono::duration<double>(t2 - t1).count();
+    }
+
+    const double n = double(files.size() - bad) * repeats;
+    std::cout << "    - " << files.size() << " fixtures (" << bytes / 1024 << " KB), " << bad << " mismatches\n";
+    if (n > 0) {
+        std::cout << "    - DOM " << dom_s / n * 1e6 << " us/response, SAX " << sax_s / n * 1e6
+                  << " us/response (x" << (sax_s > 0 ? dom_s / sax_s : 0) << ")\n";
+    }
+    return bad == 0;
+}
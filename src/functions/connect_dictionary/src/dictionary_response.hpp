@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Merriam-Webster 응답(JSON)에서 출력에 쓰는 부분만 뽑은 결과
+//   [ {entry}, {entry}, ... ]  : 앞 3개 entry 의 hwi.hw, fl, shortdef
+//   [ "word", "word", ... ]    : 표제어가 없을 때의 자동완성 제안
+//   그 외 / 빈 배열            : 정의 없음
+struct DictionaryResponse {
+    enum Kind { kNone, kSuggestions, kEntries };
+    struct Entry {
+        size_t index = 0;                   // 배열 안 위치 (Definition Set 번호)
+        std::string headword;               // hwi.hw
+        std::string pos;                    // fl
+        std::vector<std::string> defs;      // shortdef
+    };
+
+    Kind kind = kNone;
+    std::vector<std::string> suggestions;
+    std::vector<Entry> entries;             // shortdef 가 있는 entry 만 (앞 3개 안에서)
+    bool more = false;                      // 3개 뒤에 entry 가 더 있음
+
+    bool operator==(const DictionaryResponse& o) const;
+};
+
+// SAX 로 필요한 필드만 뽑고, 4번째 entry 가 시작되면 나머지는 읽지 않는다
+// (발음/어원/예문 등으로 수십 KB 인 응답도 DOM 을 만들지 않음). 잘못된 JSON 이면 nlohmann::json::parse_error 를 던진다.
+// 단 멈춘 뒤의 내용은 보지 않으므로 4번째 entry 이후가 깨진 응답은 오류 없이 읽힌다 (DOM 경로는 던짐).
+DictionaryResponse parse_dictionary_response(const std::string& raw);
+// 같은 결과를 nlohmann::json DOM 으로 (비교/벤치마크 기준)
+DictionaryResponse parse_dictionary_response_dom(const std::string& raw);
+
+// dir 의 *.json (녹화한 응답, py/record_dictionary_fixtures.py) 으로 두 경로의 결과가 같은지 확인하고 속도 비교
+// return: 모두 일치하면 true
+bool bench_dictionary_responses(const std::filesystem::path& dir, int repeats = 200);
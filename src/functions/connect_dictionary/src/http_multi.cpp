@@ -0,0 +1,187 @@
+#include "http_multi.hpp"
+
+#include <atomic>
+#include <stdexcept>
+
+namespace {
+
+size_t append_body(void* ptr, size_t size, size_t nmemb, void* user) {
+    static_cast<std::string*>(user)->append(static_cast<const char*>(ptr), size * nmemb);
+    return size * nmemb;
+}
+
+// curl_global_init 은 프로세스에서 한 번만
+void global_init_once() {
+    static const bool done = [] {
+        curl_global_init(CURL_GLOBAL_DEFAULT);
+        return true;
+    }();
+    (void)done;
+}
+
+} // namespace
+
+HttpMulti::HttpMulti(Options opt) : opt_(opt) {
+    if (opt_.max_in_flight == 0) opt_.max_in_flight = 1;
+    global_init_once();
+
+    multi_ = curl_multi_init();
+    share_ = curl_share_init();
+    if (!multi_ || !share_) throw std::runtime_error("curl_multi_init/curl_share_init failed");
+
+    // easy 핸들은 poll_mu_ 를 잡은 스레드만 전송에 쓰므로 share 잠금 콜백은 필요 없다
+    // (연결 캐시는 multi 핸들에 붙은 easy 핸들끼리 기본으로 공유된다)
+    curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+
+    curl_multi_setopt(multi_, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+    curl_multi_setopt(multi_, CURLMOPT_MAX_HOST_CONNECTIONS, (long)opt_.max_in_flight);
+}
+
+HttpMulti::~HttpMulti() {
+    for (auto& [h, job] : active_) {
+        curl_multi_remove_handle(multi_, h);
+        curl_easy_cleanup(h);
+    }
+    for (CURL* h : idle_) curl_easy_cleanup(h);
+    if (multi_) curl_multi_cleanup(multi_);
+    if (share_) curl_share_cleanup(share_);
+}
+
+void HttpMulti::set_max_in_flight(size_t n) {
+    std::lock_guard<std::mutex> lk(mu_);
+    opt_.max_in_flight = n ? n : 1;
+}
+
+size_t HttpMulti::max_in_flight() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return opt_.max_in_flight;
+}
+
+// mu_ 잡은 상태에서 호출
+CURL* HttpMulti::acquire() {
+    if (!idle_.empty()) {
+        CURL* h = idle_.back();
+        idle_.pop_back();
+        return h;
+    }
+    CURL* h = curl_easy_init();
+    if (!h) throw std::runtime_error("curl_easy_init failed");
+    curl_easy_setopt(h, CURLOPT_SHARE, share_);
+    curl_easy_setopt(h, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(h, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(h, CURLOPT_ACCEPT_ENCODING, "");   // gzip/deflate 등 지원하는 건 전부
+    curl_easy_setopt(h, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(h, CURLOPT_WRITEFUNCTION, append_body);
+    return h;
+}
+
+// poll_mu_, mu_ 잡은 상태에서 호출
+void HttpMulti::start(std::unique_ptr<Job> job) {
+    CURL* h = acquire();
+    curl_easy_setopt(h, CURLOPT_URL, job->url.c_str());
+    curl_easy_setopt(h, CURLOPT_WRITEDATA, &job->result.body);
+    curl_easy_setopt(h, CURLOPT_CONNECTTIMEOUT_MS, opt_.connect_timeout_ms);
+    curl_easy_setopt(h, CURLOPT_TIMEOUT_MS, opt_.timeout_ms);
+    curl_multi_add_handle(multi_, h);
+    active_.emplace(h, std::move(job));
+}
+
+uint64_t HttpMulti::submit(std::string url, Callback done) {
+    uint64_t id;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        id = next_id_++;
+        pending_.push_back(std::unique_ptr<Job>(new Job{ id, std::move(url), std::move(done), {} }));
+    }
+    curl_multi_wakeup(multi_);   // 다른 스레드가 poll 에서 자고 있으면 깨운다
+    return id;
+}
+
+bool HttpMulti::cancel(uint64_t ticket) {
+    std::lock_guard<std::mutex> plk(poll_mu_);
+    std::lock_guard<std::mutex> lk(mu_);
+    for (auto it = pending_.begin(); it != pending_.end(); ++it) {
+        if ((*it)->id == ticket) { pending_.erase(it); return true; }
+    }
+    for (auto it = active_.begin(); it != active_.end(); ++it) {
+        if (it->second->id != ticket) continue;
+        curl_multi_remove_handle(multi_, it->first);
+        idle_.push_back(it->first);
+        active_.erase(it);
+        return true;
+    }
+    return false;
+}
+
+size_t HttpMulti::poll(int timeout_ms) {
+    std::vector<std::unique_ptr<Job>> finished;
+    size_t left = 0;
+    {
+        std::lock_guard<std::mutex> plk(poll_mu_);
+        auto fill = [&] {
+            std::lock_guard<std::mutex> lk(mu_);
+            curl_multi_setopt(multi_, CURLMOPT_MAX_HOST_CONNECTIONS, (long)opt_.max_in_flight);
+            while (!pending_.empty() && active_.size() < opt_.max_in_flight) {
+                auto job = std::move(pending_.front());
+                pending_.pop_front();
+                start(std::move(job));
+            }
+        };
+        auto collect = [&] {
+            int still = 0;
+            curl_multi_perform(multi_, &still);
+            int queued = 0;
+            while (CURLMsg* msg = curl_multi_info_read(multi_, &queued)) {
+                if (msg->msg != CURLMSG_DONE) continue;
+                CURL* h = msg->easy_handle;
+                const CURLcode rc = msg->data.result;
+                std::lock_guard<std::mutex> lk(mu_);
+                auto it = active_.find(h);
+                if (it == active_.end()) continue;
+                Result& r = it->second->result;
+                if (rc == CURLE_OK) {
+                    curl_easy_getinfo(h, CURLINFO_RESPONSE_CODE, &r.status);
+#if LIBCURL_VERSION_NUM >= 0x074200
+                    curl_off_t wait = 0;
+                    if (curl_easy_getinfo(h, CURLINFO_RETRY_AFTER, &wait) == CURLE_OK) r.retry_after = (long)wait;
+#endif
+                } else {
+                    r.error = curl_easy_strerror(rc);
+                }
+                curl_multi_remove_handle(multi_, h);
+                idle_.push_back(h);
+                finished.push_back(std::move(it->second));
+                active_.erase(it);
+            }
+        };
+
+        fill();
+        collect();
+        if (finished.empty()) {
+            curl_multi_poll(multi_, nullptr, 0, timeout_ms, nullptr);
+            collect();
+        }
+        fill();   // 끝난 자리에 대기 요청 채우기
+
+        std::lock_guard<std::mutex> lk(mu_);
+        left = pending_.size() + active_.size();
+    }
+
+    // 콜백은 잠금 없이 (콜백 안에서 submit 가능)
+    for (auto& job : finished) job->done(std::move(job->result));
+    return left;
+}
+
+std::vector<HttpMulti::Result> HttpMulti::get_all(const std::vector<std::string>& urls) {
+    std::vector<Result> results(urls.size());
+    std::atomic<size_t> left{ urls.size() };
+    for (size_t i = 0; i < urls.size(); ++i) {
+        submit(urls[i], [&results, &left, i](Result&& r) {
+            results[i] = std::move(r);
+            --left;
+        });
+    }
+    while (left.load() > 0) poll(100);
+    return results;
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <curl/curl.h>
+
+// curl_multi 기반 동시 GET 엔진
+// - 한 번에 최대 max_in_flight 개 요청을 동시에 보내고, 나머지는 대기열에서 순서대로 시작
+// - easy 핸들을 재사용하고 HTTP keep-alive 를 유지 (같은 호스트면 연결/TLS 세션 재사용)
+// - DNS / TLS 세션 캐시를 share 핸들로 묶어 여러 배치 사이에서도 공유
+//
+// 두 가지 사용법
+//   get_all(urls)         : 동기. 결과는 입력 순서
+//   submit(url, cb) + poll: 비동기. 아무 스레드에서나 submit, poll 을 부르는 스레드가 전송을 진행하고
+//                           끝난 요청의 콜백을 실행한다 (poll 은 내부에서 직렬화됨)
+class HttpMulti {
+public:
+    struct Options {
+        size_t max_in_flight = 4;
+        long   connect_timeout_ms = 10000;
+        long   timeout_ms = 30000;          // 요청 하나당 전체 시간 제한
+    };
+    struct Result {
+        long        status = 0;             // HTTP 상태 코드 (전송 실패면 0)
+        std::string body;
+        std::string error;                  // curl 오류 메시지 (성공이면 빈 문자열)
+        long        retry_after = 0;        // Retry-After 헤더 (초, 없으면 0)
+        bool ok() const { return error.empty() && status >= 200 && status < 300; }
+    };
+    using Callback = std::function<void(Result&&)>;
+
+    explicit HttpMulti(Options opt);
+    ~HttpMulti();
+    HttpMulti(const HttpMulti&) = delete;
+    HttpMulti& operator=(const HttpMulti&) = delete;
+
+    std::vector<Result> get_all(const std::vector<std::string>& urls);
+    Result get(const std::string& url) { return get_all({ url }).front(); }
+
+    // 요청 예약, 반환: 취소용 번호. done 은 poll() 을 부른 스레드에서 (잠금 없이) 호출된다
+    uint64_t submit(std::string url, Callback done);
+    // 끝나지 않은 요청 취소 (콜백은 불리지 않음). 이미 끝났거나 없으면 false. 콜백 안에서 부르지 말 것
+    bool cancel(uint64_t ticket);
+    // 대기 요청 시작 + 전송 진행 + 끝난 요청 콜백. 할 일이 없으면 최대 timeout_ms 대기
+    // 반환: 아직 남은 요청 수 (대기 + 진행 중)
+    size_t poll(int timeout_ms);
+
+    void set_max_in_flight(size_t n);
+    size_t max_in_flight() const;
+
+private:
+    struct Job {
+        uint64_t id;
+        std::string url;
+        Callback done;
+        Result result;
+    };
+
+    CURL* acquire();
+    void start(std::unique_ptr<Job> job);
+
+    Options opt_;
+    mutable std::mutex mu_;             // opt_, pending_, active_, idle_ 보호
+    std::mutex poll_mu_;                // curl_multi_* 호출 직렬화 (항상 mu_ 보다 먼저 잡음)
+    CURLM*  multi_ = nullptr;
+    CURLSH* share_ = nullptr;
+    std::vector<CURL*> idle_;           // 재사용할 easy 핸들
+    std::deque<std::unique_ptr<Job>> pending_;
+    std::unordered_map<CURL*, std::unique_ptr<Job>> active_;
+    uint64_t next_id_ = 1;
+};
@@ -0,0 +1,295 @@
+#include "offline_dictionary.hpp"
+#include "image_loader.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+struct OfflineDictionary::Entry {
+    uint32_t hash;
+    uint32_t key_off;
+    uint32_t key_len;
+    uint32_t val_off;
+    uint32_t val_len;
+};
+
+namespace {
+
+const char     kMagic[8] = { 'E','2','V','O','D','I','C','\0' };
+const uint32_t kVersion  = 1;
+
+struct Header {
+    char     magic[8];
+    uint32_t version;
+    uint32_t count;         // 키 수
+    uint32_t slot_count;    // 2 의 거듭제곱
+    uint32_t reserved;
+    uint64_t blob_size;
+};
+static_assert(sizeof(Header) == 32, "unexpected Header padding");
+
+const size_t kKeptEntries = 3;   // 출력에 쓰는 entry 수 (format_definition 과 같음)
+
+uint32_t fnv1a(std::string_view s) {
+    uint32_t h = 2166136261u;
+    for (unsigned char c : s) h = (h ^ c) * 16777619u;
+    return h;
+}
+
+std::string lower(std::string_view s) {
+    std::string k(s);
+    for (auto& c : k) c = (char)std::tolower((unsigned char)c);
+    return k;
+}
+
+size_t align4(size_t n) { return (n + 3) & ~size_t(3); }
+
+const char kDumpJsonl[] = "dictionary.jsonl";
+const char kDumpBin[]   = "dictionary.bin";
+
+// 응답의 표제어: meta.id ("run:1" → "run"), 없으면 hwi.hw ("run*ner" → "runner")
+std::string headword_of(const json& arr) {
+    for (const auto& e : arr) {
+        if (!e.is_object()) continue;
+        auto meta = e.find("meta");
+        if (meta != e.end() && meta->is_object()) {
+            auto id = meta->find("id");
+            if (id != meta->end() && id->is_string()) {
+                const std::string& s = id->get_ref<const std::string&>();
+                return lower(s.substr(0, s.find(':')));
+            }
+        }
+        auto hwi = e.find("hwi");
+        if (hwi != e.end() && hwi->is_object()) {
+            auto hw = hwi->find("hw");
+            if (hw != hwi->end() && hw->is_string()) {
+                std::string s = hw->get<std::string>();
+                s.erase(std::remove(s.begin(), s.end(), '*'), s.end());
+                return lower(s);
+            }
+        }
+    }
+    return {};
+}
+
+// entry 에서 출력에 쓰는 필드만 남긴다 (parse_dictionary_response 결과가 원본과 같도록)
+json trim_entry(const json& e) {
+    if (!e.is_object()) return e;
+    json t = json::object();
+    auto hwi = e.find("hwi");
+    if (hwi != e.end() && hwi->is_object()) {
+        auto hw = hwi->find("hw");
+        if (hw != hwi->end() && hw->is_string()) t["hwi"] = json{ { "hw", *hw } };
+    }
+    auto fl = e.find("fl");
+    if (fl != e.end() && fl->is_string()) t["fl"] = *fl;
+    auto sd = e.find("shortdef");
+    if (sd != e.end()) t["shortdef"] = *sd;
+    return t;
+}
+
+OfflineDictionary load_dump_auto() {
+    std::string source;
+    OfflineDictionary d = load_or_rebuild_image(kDumpJsonl, kDumpBin, OfflineDictionary::from_jsonl,
+                                                OfflineDictionary::open_image, &source);
+    if (!source.empty())
+        std::cout << "[info] loaded " << d.size() << " offline dictionary entries from " << source << "\n";
+    return d;
+}
+
+} // namespace
+
+OfflineDictionary OfflineDictionary::from_jsonl(const fs::path& jsonl) {
+    std::ifstream in(jsonl, std::ios::binary);
+    if (!in) throw std::runtime_error("cannot open: " + jsonl.string());
+
+    std::vector<std::string> order;                        // 처음 나온 순서 (출력 재현용)
+    std::unordered_map<std::string, json> merged;          // 표제어 → entry 배열
+    std::vector<std::pair<std::string, std::string>> stems; // 변화형 → 표제어
+    std::string line;
+    size_t line_no = 0, skipped = 0;
+    while (std::getline(in, line)) {
+        ++line_no;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+
+        json arr = json::parse(line, nullptr, false);
+        if (arr.is_discarded() || !arr.is_array())
+            throw std::runtime_error("offline dictionary: bad line " + std::to_string(line_no));
+        const std::string hw = headword_of(arr);
+        if (hw.empty()) { ++skipped; continue; }     // 제안 목록/빈 응답
+
+        for (const auto& e : arr) {
+            if (!e.is_object()) continue;
+            auto meta = e.find("meta");
+            if (meta == e.end() || !meta->is_object()) continue;
+            auto st = meta->find("stems");
+            if (st == meta->end() || !st->is_array()) continue;
+            for (const auto& s : *st) {
+                if (s.is_string()) stems.emplace_back(lower(s.get_ref<const std::string&>()), hw);
+            }
+        }
+
+        // 앞 3개만 다듬어 두고, 그 뒤는 "더 있음" 표시용 빈 entry 하나면 된다
+        auto [it, inserted] = merged.try_emplace(hw, json::array());
+        if (inserted) order.push_back(hw);
+        for (const auto& e : arr) {
+            json& kept = it->second;
+            if (kept.size() < kKeptEntries) kept.push_back(trim_entry(e));
+            else if (kept.size() == kKeptEntries) kept.push_back(json::object());
+            else break;
+        }
+    }
+    if (skipped) std::cerr << "[warn] offline dictionary: skipped " << skipped << " lines without a headword\n";
+
+    // 값(응답)은 표제어마다 한 번만 저장하고, 변화형 키는 같은 값을 가리킨다
+    std::string blob;
+    std::vector<Entry> entries;
+    std::unordered_map<std::string, size_t> key_index;     // 키 → entries 위치
+    std::unordered_map<std::string, std::pair<uint32_t, uint32_t>> value_of;
+    auto add_key = [&](const std::string& key, std::pair<uint32_t, uint32_t> val) {
+        if (!key_index.emplace(key, entries.size()).second) return;
+        Entry e{};
+        e.hash = fnv1a(key);
+        e.key_off = (uint32_t)blob.size();
+        e.key_len = (uint32_t)key.size();
+        e.val_off = val.first;
+        e.val_len = val.second;
+        blob += key;
+        entries.push_back(e);
+    };
+    for (const auto& hw : order) {
+        const std::string value = merged[hw].dump();
+        const std::pair<uint32_t, uint32_t> val{ (uint32_t)blob.size(), (uint32_t)value.size() };
+        blob += value;
+        value_of.emplace(hw, val);
+        add_key(hw, val);
+    }
+    for (const auto& [stem, hw] : stems) add_key(stem, value_of[hw]);
+    if (blob.size() > UINT32_MAX) throw std::runtime_error("offline dictionary: dump too large");
+
+    const uint32_t count = (uint32_t)entries.size();
+    uint32_t slot_count = 2;
+    while (slot_count < count * 2) slot_count <<= 1;
+
+    const size_t off_slots   = sizeof(Header);
+    const size_t off_entries = off_slots + size_t(slot_count) * 4;
+    const size_t off_blob    = off_entries + entries.size() * sizeof(Entry);
+    const size_t total       = off_blob + blob.size();
+
+    std::vector<uint32_t> img((align4(total)) / 4, 0);
+    char* base = reinterpret_cast<char*>(img.data());
+
+    Header h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = kVersion;
+    h.count = count;
+    h.slot_count = slot_count;
+    h.blob_size = blob.size();
+    std::memcpy(base, &h, sizeof(h));
+
+    uint32_t* slots = reinterpret_cast<uint32_t*>(base + off_slots);
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t s = entries[i].hash & (slot_count - 1);
+        while (slots[s]) s = (s + 1) & (slot_count - 1);
+        slots[s] = i + 1;
+    }
+    std::memcpy(base + off_entries, entries.data(), entries.size() * sizeof(Entry));
+    std::memcpy(base + off_blob, blob.data(), blob.size());
+
+    OfflineDictionary d;
+    d.owned_ = std::move(img);
+    d.bind(reinterpret_cast<const char*>(d.owned_.data()), total);
+    return d;
+}
+
+OfflineDictionary OfflineDictionary::open_image(const fs::path& path) {
+    OfflineDictionary d;
+    d.map_ = MappedFile(path);
+    d.bind(d.map_.data(), d.map_.size());
+    return d;
+}
+
+void OfflineDictionary::bind(const char* base, size_t size) {
+    Header h;
+    if (!base || size < sizeof(Header))
+        throw std::runtime_error("offline dictionary image: truncated header");
+    std::memcpy(&h, base, sizeof(h));
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0 || h.version != kVersion)
+        throw std::runtime_error("offline dictionary image: bad magic/version");
+    if (h.slot_count == 0 || (h.slot_count & (h.slot_count - 1)) != 0 || h.count >= h.slot_count)
+        throw std::runtime_error("offline dictionary image: bad slot count");
+
+    const size_t off_entries = sizeof(Header) + size_t(h.slot_count) * 4;
+    const size_t off_blob    = off_entries + size_t(h.count) * sizeof(Entry);
+    if (off_blob + h.blob_size != size)
+        throw std::runtime_error("offline dictionary image: size mismatch");
+
+    image_      = base;
+    image_size_ = size;
+    count_      = h.count;
+    mask_       = h.slot_count - 1;
+    slots_      = reinterpret_cast<const uint32_t*>(base + sizeof(Header));
+    entries_    = reinterpret_cast<const Entry*>(base + off_entries);
+    blob_       = base + off_blob;
+    blob_size_  = h.blob_size;
+}
+
+void OfflineDictionary::save_image(const fs::path& path) const {
+    if (!image_) throw std::runtime_error("offline dictionary image: nothing to save");
+    fs::path tmp = path;
+    tmp += ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) throw std::runtime_error("failed to create: " + tmp.string());
+        out.write(image_, (std::streamsize)image_size_);
+        if (!out) throw std::runtime_error("failed to write: " + tmp.string());
+    }
+    fs::rename(tmp, path);
+}
+
+bool OfflineDictionary::find(std::string_view word, std::string_view& raw) const {
+    if (!count_) return false;
+    const std::string key = lower(word);
+    const uint32_t h = fnv1a(key);
+    for (uint32_t s = h & mask_; slots_[s]; s = (s + 1) & mask_) {
+        const uint32_t id = slots_[s] - 1;
+        if (id >= count_) return false;                    // 깨진 이미지
+        const Entry& e = entries_[id];
+        // 위치는 열 때 전부 검사하지 않고(매핑 전체를 건드리게 됨) 맞는 키에서만 확인
+        if (e.hash == h && e.key_len == key.size()
+            && uint64_t(e.key_off) + e.key_len <= blob_size_
+            && std::memcmp(blob_ + e.key_off, key.data(), key.size()) == 0) {
+            if (uint64_t(e.val_off) + e.val_len > blob_size_) return false;
+            raw = std::string_view(blob_ + e.val_off, e.val_len);
+            return true;
+        }
+    }
+    return false;
+}
+
+const OfflineDictionary* default_offline_dictionary() {
+    static const OfflineDictionary d = load_dump_auto();
+    return d.empty() ? nullptr : &d;
+}
+
+int compile_offline_dictionary() {
+    const auto p = locate_data_file(kDumpJsonl);
+    if (p.empty()) {
+        std::cerr << "[warn] cannot find " << kDumpJsonl << " (tried CWD and exe dir; see py/wordnet_gloss_dump.py)\n";
+        return 0;
+    }
+    OfflineDictionary d = rebuild_image(p, OfflineDictionary::from_jsonl);
+    std::cout << "[info] compiled " << d.size() << " offline dictionary entries → "
+              << image_path_for(p).string() << "\n";
+    return 1;
+}
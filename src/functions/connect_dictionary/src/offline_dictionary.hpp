@@ -0,0 +1,65 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mmap_file.hpp"
+
+// 네트워크 없이 쓰는 사전 (표제어 → Merriam-Webster 모양 응답 JSON)
+//
+// 원본 dictionary.jsonl : 한 줄에 응답 하나 (사전 API 응답과 같은 모양의 JSON 배열)
+//   표제어는 첫 entry 의 meta.id (":1" 같은 동형어 번호 제거), 없으면 hwi.hw ('*' 음절 표시 제거)
+//   meta.stems 의 변화형도 (다른 표제어와 겹치지 않으면) 같은 응답을 가리킨다
+//   같은 표제어가 여러 줄이면 entry 를 이어 붙인다. WordNet 뜻풀이는 py/wordnet_gloss_dump.py 로 만든다.
+//   저장하는 값은 출력에 쓰는 hwi.hw / fl / shortdef 만 남긴 앞 3개 entry (+ 더 있으면 빈 entry 하나)
+//
+// 바이너리 이미지 dictionary.bin (리틀 엔디언, 4바이트 정렬)
+//   Header               : magic, version, count, slot_count, blob_size
+//   uint32 slot[slots]   : 0 = 빈 칸, 아니면 entry 번호 + 1 (FNV-1a, 선형 탐사, 적재율 <= 1/2)
+//   Entry  entry[count]  : hash, key 위치/길이, value 위치/길이 (blob 기준)
+//   char   blob[]        : key/value 바이트
+// 키는 소문자. 조회는 해시 한 번 + 평균 1~2 칸 탐사.
+class OfflineDictionary {
+public:
+    OfflineDictionary() = default;
+
+    // JSON lines 덤프를 읽어 메모리 이미지를 만든다. 형식 오류는 예외(std::runtime_error)
+    static OfflineDictionary from_jsonl(const std::filesystem::path& jsonl);
+    // 이미지 파일을 mmap 으로 연다. 형식이 맞지 않으면 예외(std::runtime_error)
+    static OfflineDictionary open_image(const std::filesystem::path& path);
+    // 현재 이미지를 파일로 저장 (임시 파일 → rename)
+    void save_image(const std::filesystem::path& path) const;
+
+    // 표제어(대소문자 무시)의 응답 JSON. 없으면 false
+    bool find(std::string_view word, std::string_view& raw) const;
+
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    bool mapped() const { return !map_.empty(); }
+
+private:
+    struct Entry;
+    void bind(const char* base, size_t size);
+
+    MappedFile  map_;               // mmap 백업 (open_image)
+    std::vector<uint32_t> owned_;   // 메모리 백업 (from_jsonl)
+    const char* image_ = nullptr;
+    size_t      image_size_ = 0;
+
+    uint32_t        count_ = 0;
+    uint32_t        mask_ = 0;      // slot_count - 1
+    const uint32_t* slots_ = nullptr;
+    const Entry*    entries_ = nullptr;
+    const char*     blob_ = nullptr;
+    uint64_t        blob_size_ = 0;
+};
+
+// exe 옆(또는 CWD)의 dictionary.bin/.jsonl 을 한 번만 열어 둔 인스턴스 (없으면 nullptr)
+// jsonl 이 이미지보다 새로우면 이미지를 다시 만든다
+const OfflineDictionary* default_offline_dictionary();
+
+// dictionary.jsonl → .bin 재생성. return: 만든 이미지 수 (0 = 덤프 없음)
+int compile_offline_dictionary();
@@ -0,0 +1,159 @@
+#include "request_scheduler.hpp"
+
+#include <algorithm>
+#include <utility>
+
+RequestScheduler::RequestScheduler(HttpMulti& http, Options opt)
+    : http_(http), opt_(opt), rng_(std::random_device{}()) {
+    if (opt_.burst < 1) opt_.burst = 1;
+    if (opt_.max_retries < 0) opt_.max_retries = 0;
+    tokens_ = opt_.burst;
+    refilled_ = Clock::now();
+}
+
+// mu_ 잡은 상태에서 호출
+void RequestScheduler::refill(Clock::time_point now) {
+    if (opt_.rate_per_sec > 0) {
+        const double dt = std::chrono::duration<double>(now - refilled_).count();
+        tokens_ = std::min(opt_.burst, tokens_ + dt * opt_.rate_per_sec);
+    }
+    refilled_ = now;
+}
+
+bool RequestScheduler::retryable(const Result& r) const {
+    return !r.error.empty() || r.status == 429 || r.status >= 500;
+}
+
+// 지수 백오프 + equal jitter: d = min(cap, base·2^(n-1)), 실제 대기는 d/2 + [0, d/2)
+RequestScheduler::Clock::duration RequestScheduler::backoff(int attempts) {
+    const int shift = std::min(attempts - 1, 20);
+    const long d = std::min(opt_.backoff_cap_ms, opt_.backoff_base_ms << std::max(shift, 0));
+    const long half = std::max(d / 2, 1L);
+    std::uniform_int_distribution<long> jitter(0, half - 1);
+    return std::chrono::milliseconds(d - half + jitter(rng_));
+}
+
+uint64_t RequestScheduler::submit(std::string url, Callback done) {
+    uint64_t id;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        if (jobs_.empty()) {
+            deadline_ = opt_.batch_budget_ms > 0 ? Clock::now() + std::chrono::milliseconds(opt_.batch_budget_ms)
+                                                 : Clock::time_point::max();
+        }
+        id = next_id_++;
+        Job job;
+        job.url = std::move(url);
+        job.done = std::move(done);
+        jobs_.emplace(id, std::move(job));
+    }
+    return id;
+}
+
+bool RequestScheduler::cancel(uint64_t ticket) {
+    uint64_t http_ticket = 0;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        auto it = jobs_.find(ticket);
+        if (it == jobs_.end()) return false;
+        http_ticket = it->second.http_ticket;
+        jobs_.erase(it);
+    }
+    // 이미 끝나 finished_ 에 들어가 있으면 poll 이 번호를 못 찾고 버린다
+    if (http_ticket) http_.cancel(http_ticket);
+    return true;
+}
+
+size_t RequestScheduler::poll(int timeout_ms) {
+    std::vector<std::pair<Callback, Result>> done;
+    int wait_ms = timeout_ms;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        const auto now = Clock::now();
+        refill(now);
+        const bool expired = now >= deadline_;
+        auto next = Clock::time_point::max();   // 다음에 시작할 수 있는 때
+
+        for (auto it = jobs_.begin(); it != jobs_.end();) {
+            Job& job = it->second;
+            if (job.http_ticket) { ++it; continue; }
+            if (expired) {
+                Result r;
+                r.error = "deadline budget exhausted";
+                ++stats_.failed;
+                ++stats_.expired;
+                done.emplace_back(std::move(job.done), std::move(r));
+                it = jobs_.erase(it);
+                continue;
+            }
+            if (job.not_before > now) { next = std::min(next, job.not_before); ++it; continue; }
+            if (now < paused_until_) { next = std::min(next, paused_until_); ++it; continue; }
+            if (opt_.rate_per_sec > 0 && tokens_ < 1) {
+                const double need = (1 - tokens_) / opt_.rate_per_sec;
+                next = std::min(next, now + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(need)));
+                ++it;
+                continue;
+            }
+
+            if (opt_.rate_per_sec > 0) tokens_ -= 1;
+            ++job.attempts;
+            ++stats_.sent;
+            const uint64_t id = it->first;
+            job.http_ticket = http_.submit(job.url, [this, id](Result&& r) {
+                std::lock_guard<std::mutex> lk(mu_);
+                finished_.push_back({ id, std::move(r) });
+            });
+            ++it;
+        }
+
+        if (!done.empty() || !finished_.empty()) wait_ms = 0;
+        else if (next != Clock::time_point::max()) {
+            const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(next - now).count() + 1;
+            wait_ms = (int)std::min<long long>(wait_ms, ms);
+        }
+    }
+
+    http_.poll(wait_ms);
+
+    size_t left = 0;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        const auto now = Clock::now();
+        for (auto& f : finished_) {
+            auto it = jobs_.find(f.id);
+            if (it == jobs_.end()) continue;    // 취소됨
+            Job& job = it->second;
+            job.http_ticket = 0;
+            Result& r = f.result;
+            if (r.status == 429) ++stats_.throttled;
+
+            if (retryable(r) && job.attempts <= opt_.max_retries && now < deadline_) {
+                auto delay = backoff(job.attempts);
+                if (r.retry_after > 0) {
+                    const auto server = std::chrono::seconds(r.retry_after);
+                    delay = std::max<Clock::duration>(delay, server);
+                    paused_until_ = std::max(paused_until_, now + server);
+                }
+                if (r.status == 429) tokens_ = 0;   // 쿼터 초과: 버킷을 비워 전체 속도를 늦춘다
+                job.not_before = now + delay;
+                ++stats_.retries;
+                continue;
+            }
+
+            if (!r.ok()) ++stats_.failed;
+            done.emplace_back(std::move(job.done), std::move(r));
+            jobs_.erase(it);
+        }
+        finished_.clear();
+        left = jobs_.size();
+    }
+
+    // 콜백은 잠금 없이 (콜백 안에서 submit 가능)
+    for (auto& [cb, r] : done) cb(std::move(r));
+    return left;
+}
+
+RequestScheduler::Stats RequestScheduler::stats() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return stats_;
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "http_multi.hpp"
+
+// HttpMulti 앞에 두는 요청 스케줄러 (사전 API 쿼터 대응)
+// - 토큰 버킷: 초당 rate_per_sec 개, 최대 burst 개까지 몰아서 시작. 토큰이 없으면 대기열에서 기다린다
+// - 재시도: 전송 실패 / 429 / 5xx 는 지수 백오프 + 지터 (base·2^n 상한 cap, 절반은 무작위) 후 다시 보낸다
+//   429 에 Retry-After 가 있으면 그 시간 동안 버킷 전체를 멈춘다 (다른 요청도 같이 쉼)
+// - 배치 시한: 스케줄러가 비어 있다가 첫 요청이 들어온 때부터 batch_budget_ms 가 지나면
+//   아직 시작 못 했거나 백오프 중인 요청은 "deadline budget exhausted" 오류로 끝내고 더는 재시도하지 않는다
+// 요청 하나당 시간 제한은 HttpMulti::Options::timeout_ms
+//
+// 사용법은 HttpMulti 의 submit/cancel/poll 과 같다. 콜백은 poll 을 부른 스레드에서 잠금 없이,
+// 최종 결과(성공, 재시도 불가 오류, 재시도 소진, 시한 초과)로 딱 한 번 불린다
+class RequestScheduler {
+public:
+    struct Options {
+        double rate_per_sec = 10;       // 0 이하면 제한 없음
+        double burst = 5;
+        int    max_retries = 4;         // 첫 시도 뒤 최대 재시도 횟수
+        long   backoff_base_ms = 500;
+        long   backoff_cap_ms = 30000;
+        long   batch_budget_ms = 0;     // 0 이면 시한 없음
+    };
+    struct Stats {
+        uint64_t sent = 0;              // HttpMulti 로 보낸 횟수 (재시도 포함)
+        uint64_t retries = 0;
+        uint64_t throttled = 0;         // 429 응답
+        uint64_t failed = 0;            // 최종 실패 (시한 초과 포함)
+        uint64_t expired = 0;           // 시한 초과로 끝낸 요청
+    };
+    using Result = HttpMulti::Result;
+    using Callback = HttpMulti::Callback;
+
+    RequestScheduler(HttpMulti& http, Options opt);
+    RequestScheduler(const RequestScheduler&) = delete;
+    RequestScheduler& operator=(const RequestScheduler&) = delete;
+
+    // 요청 예약, 반환: 취소용 번호
+    uint64_t submit(std::string url, Callback done);
+    // 끝나지 않은 요청 취소 (콜백은 불리지 않음). 콜백 안에서 부르지 말 것
+    bool cancel(uint64_t ticket);
+    // 토큰이 있는 만큼 시작 + 전송 진행 + 끝난 요청 처리(재시도 예약 또는 콜백)
+    // 반환: 아직 끝나지 않은 요청 수 (대기 + 백오프 + 진행 중)
+    size_t poll(int timeout_ms);
+
+    Stats stats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Job {
+        std::string url;
+        Callback done;
+        int attempts = 0;
+        Clock::time_point not_before{};
+        uint64_t http_ticket = 0;       // 0 이면 HttpMulti 에 없음 (대기 또는 백오프 중)
+    };
+    struct Finished {
+        uint64_t id;
+        Result result;
+    };
+
+    void refill(Clock::time_point now);
+    bool retryable(const Result& r) const;
+    Clock::duration backoff(int attempts);
+
+    HttpMulti& http_;
+    Options opt_;
+    mutable std::mutex mu_;                 // 아래 전부 보호. 잡은 채로 HttpMulti::cancel/poll 을 부르지 않는다
+    std::map<uint64_t, Job> jobs_;          // 번호 순 = 먼저 온 순서
+    std::vector<Finished> finished_;        // HttpMulti 콜백이 채우고 poll 이 처리
+    double tokens_;
+    Clock::time_point refilled_;
+    Clock::time_point paused_until_{};      // Retry-After
+    Clock::time_point deadline_ = Clock::time_point::max();
+    std::mt19937_64 rng_;
+    Stats stats_;
+    uint64_t next_id_ = 1;
+};
@@ -0,0 +1,83 @@
+#include "dictionary_response.hpp"
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+// ---- 사전 응답 파서: SAX 경로 vs DOM 경로 ----
+// fixtures/ 는 Merriam-Webster 응답 모양을 흉내 낸 작은 녹화본 (entry / 제안 목록 / 빈 배열 / 오류 객체,
+// 4개 이상 entry, shortdef 없는 entry, 같은 키 중복, 비문자열 shortdef 등)
+
+namespace {
+
+const fs::path kFixtures = EPUB2VOCAB_DICTIONARY_FIXTURES;
+
+std::string read_file(const fs::path& p) {
+    std::ifstream in(p, std::ios::binary);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+std::vector<fs::path> fixtures() {
+    std::vector<fs::path> files;
+    for (const auto& de : fs::directory_iterator(kFixtures))
+        if (de.path().extension() == ".json") files.push_back(de.path());
+    return files;
+}
+
+} // namespace
+
+TEST(DictionaryResponse, SaxMatchesDomOnFixtures) {
+    const auto files = fixtures();
+    ASSERT_GE(files.size(), 10u);
+    for (const auto& f : files) {
+        SCOPED_TRACE(f.filename().string());
+        const std::string raw = read_file(f);
+        EXPECT_TRUE(parse_dictionary_response(raw) == parse_dictionary_response_dom(raw));
+    }
+    EXPECT_TRUE(bench_dictionary_responses(kFixtures, 1));
+}
+
+TEST(DictionaryResponse, FixtureKinds) {
+    EXPECT_EQ(parse_dictionary_response(read_file(kFixtures / "suggestions.json")).kind, DictionaryResponse::kSuggestions);
+    EXPECT_EQ(parse_dictionary_response(read_file(kFixtures / "empty.json")).kind, DictionaryResponse::kNone);
+    EXPECT_EQ(parse_dictionary_response(read_file(kFixtures / "not_array.json")).kind, DictionaryResponse::kNone);
+
+    const DictionaryResponse run = parse_dictionary_response(read_file(kFixtures / "run.json"));
+    EXPECT_EQ(run.kind, DictionaryResponse::kEntries);
+    EXPECT_TRUE(run.more);
+    ASSERT_EQ(run.entries.size(), 3u);
+    EXPECT_EQ(run.entries[0].headword, "run");
+    EXPECT_EQ(run.entries[2].headword, "run-down");
+
+    const DictionaryResponse dup = parse_dictionary_response(read_file(kFixtures / "duplicate_keys.json"));
+    ASSERT_EQ(dup.entries.size(), 1u);
+    EXPECT_EQ(dup.entries[0].headword, "second");
+    EXPECT_EQ(dup.entries[0].pos, "verb");
+    EXPECT_EQ(dup.entries[0].defs, (std::vector<std::string>{ "two", "three" }));
+}
+
+TEST(DictionaryResponse, MalformedJsonThrowsParseError) {
+    for (const char* raw : { "", "[", "[{\"hwi\":", "[\"a\",]", "<html>Key limit exceeded</html>", "[1 2]" }) {
+        SCOPED_TRACE(raw);
+        EXPECT_THROW(parse_dictionary_response(raw), json::parse_error);
+        EXPECT_THROW(parse_dictionary_response_dom(raw), json::parse_error);
+    }
+}
+
+TEST(DictionaryResponse, StopsBeforeTrailingGarbage) {
+    // 4번째 entry 가 시작되면 멈추므로 그 뒤가 깨져 있어도 SAX 경로는 앞 3개를 돌려준다
+    const std::string raw = R"([{"shortdef":["a"]},{"shortdef":["b"]},{"shortdef":["c"]},{"shortdef":)";
+    const DictionaryResponse r = parse_dictionary_response(raw);
+    EXPECT_EQ(r.entries.size(), 3u);
+    EXPECT_TRUE(r.more);
+}
@@ -0,0 +1,199 @@
+#include "http_multi.hpp"
+#include "request_scheduler.hpp"
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <vector>
+
+// ---- HttpMulti / RequestScheduler: py/mock_dictionary_server.py 상대로 ----
+// ctest 는 mock 서버를 --run 으로 띄우고 이 실행 파일에 EPUB2VOCAB_MOCK_URL (http://127.0.0.1:<port>/json/) 을 넘긴다
+//   HttpMulti.*        : 실패 없는 서버
+//   RequestScheduler.* : --fail-rate 0.5 --retry-after 1 --seed 7 서버
+
+using json = nlohmann::json;
+
+namespace {
+
+std::string mock_url() {
+    const char* u = std::getenv("EPUB2VOCAB_MOCK_URL");
+    return u ? u : "";
+}
+
+// /json/ 앞까지 (http://127.0.0.1:<port>/)
+std::string mock_root() {
+    const std::string u = mock_url();
+    return u.substr(0, u.size() - std::string("json/").size());
+}
+
+json mock_stats(HttpMulti& http, const char* path = "stats") {
+    const HttpMulti::Result r = http.get(mock_root() + path);
+    EXPECT_TRUE(r.ok()) << r.status << " " << r.error;
+    return json::parse(r.body);
+}
+
+bool defines(const HttpMulti::Result& r, const std::string& word) {
+    return r.ok() && r.body.find("mock definition of " + word) != std::string::npos;
+}
+
+#define REQUIRE_MOCK()                                                              \
+    do {                                                                            \
+        if (mock_url().empty()) GTEST_SKIP() << "EPUB2VOCAB_MOCK_URL not set";       \
+    } while (0)
+
+} // namespace
+
+TEST(HttpMulti, GetAllKeepsInputOrder) {
+    REQUIRE_MOCK();
+    HttpMulti http(HttpMulti::Options{ 8 });
+    // 앞 요청일수록 늦게 끝나도록 지연을 준다
+    std::vector<std::string> urls, words;
+    for (int i = 0; i < 8; ++i) {
+        words.push_back("order" + std::to_string(i));
+        urls.push_back(mock_url() + words.back() + "?delay=" + std::to_string(0.05 * (8 - i)));
+    }
+    const auto results = http.get_all(urls);
+    ASSERT_EQ(results.size(), urls.size());
+    for (size_t i = 0; i < results.size(); ++i) EXPECT_TRUE(defines(results[i], words[i])) << i;
+}
+
+TEST(HttpMulti, MaxInFlightLimitHolds) {
+    REQUIRE_MOCK();
+    HttpMulti http(HttpMulti::Options{ 3 });
+    mock_stats(http, "stats/reset");
+
+    std::vector<std::string> urls;
+    for (int i = 0; i < 12; ++i) urls.push_back(mock_url() + "limit" + std::to_string(i) + "?delay=0.1");
+    for (const auto& r : http.get_all(urls)) EXPECT_TRUE(r.ok());
+
+    const json s = mock_stats(http);
+    EXPECT_EQ(s["requests"].get<int>(), 12);
+    EXPECT_LE(s["max_in_flight"].get<int>(), 3);
+    EXPECT_GE(s["max_in_flight"].get<int>(), 2);   // 실제로 겹쳐 보냈는지
+
+    // 실행 중에 줄이면 다음 요청부터 적용
+    http.set_max_in_flight(1);
+    mock_stats(http, "stats/reset");
+    for (const auto& r : http.get_all({ urls.begin(), urls.begin() + 4 })) EXPECT_TRUE(r.ok());
+    EXPECT_EQ(mock_stats(http)["max_in_flight"].get<int>(), 1);
+}
+
+TEST(HttpMulti, CancelSkipsCallback) {
+    REQUIRE_MOCK();
+    HttpMulti http(HttpMulti::Options{ 2 });
+    std::set<int> called;
+    std::vector<uint64_t> tickets;
+    for (int i = 0; i < 4; ++i) {
+        tickets.push_back(http.submit(mock_url() + "cancel" + std::to_string(i) + "?delay=0.3",
+                                      [&called, i](HttpMulti::Result&& r) {
+                                          EXPECT_TRUE(r.ok());
+                                          called.insert(i);
+                                      }));
+    }
+    http.poll(0);                           // 0, 1 시작 (2, 3 은 대기)
+    EXPECT_TRUE(http.cancel(tickets[0]));   // 진행 중
+    EXPECT_TRUE(http.cancel(tickets[3]));   // 대기 중
+    EXPECT_FALSE(http.cancel(tickets[3]));  // 이미 취소
+    while (http.poll(100) > 0) {}
+    EXPECT_EQ(called, (std::set<int>{ 1, 2 }));
+    EXPECT_FALSE(http.cancel(tickets[1]));  // 이미 끝남
+}
+
+TEST(RequestScheduler, RetriesUntilSuccess) {
+    REQUIRE_MOCK();
+    HttpMulti http(HttpMulti::Options{ 4 });
+    mock_stats(http, "stats/reset");
+
+    RequestScheduler::Options opt;
+    opt.rate_per_sec = 0;
+    opt.max_retries = 10;
+    opt.backoff_base_ms = 10;
+    opt.backoff_cap_ms = 40;
+    RequestScheduler sched(http, opt);
+
+    const int n = 16;
+    std::vector<HttpMulti::Result> results(n);
+    std::vector<int> calls(n, 0);
+    for (int i = 0; i < n; ++i) {
+        sched.submit(mock_url() + "retry" + std::to_string(i), [&, i](HttpMulti::Result&& r) {
+            results[i] = std::move(r);
+            ++calls[i];
+        });
+    }
+    const auto t0 = std::chrono::steady_clock::now();
+    while (sched.poll(100) > 0) {}
+    const auto elapsed = std::chrono::steady_clock::now() - t0;
+
+    for (int i = 0; i < n; ++i) {
+        EXPECT_EQ(calls[i], 1) << i;
+        EXPECT_TRUE(defines(results[i], "retry" + std::to_string(i))) << i << ": " << results[i].status;
+    }
+    const RequestScheduler::Stats st = sched.stats();
+    const json s = mock_stats(http);
+    EXPECT_GT(st.retries, 0u);
+    EXPECT_EQ(st.sent, n + st.retries);
+    EXPECT_EQ(st.failed, 0u);
+    EXPECT_EQ(s["failures"].get<uint64_t>(), st.retries);
+    EXPECT_EQ(s["requests"].get<uint64_t>(), st.sent);
+    // 429 의 Retry-After: 1 동안 버킷 전체가 멈췄어야 함
+    if (st.throttled > 0) {
+        EXPECT_GE(elapsed, std::chrono::seconds(1));
+    }
+}
+
+TEST(RequestScheduler, GivesUpAfterMaxRetries) {
+    REQUIRE_MOCK();
+    HttpMulti http(HttpMulti::Options{ 4 });
+
+    RequestScheduler::Options opt;
+    opt.rate_per_sec = 0;
+    opt.max_retries = 0;
+    RequestScheduler sched(http, opt);
+
+    const int n = 16;
+    std::vector<HttpMulti::Result> results(n);
+    for (int i = 0; i < n; ++i)
+        sched.submit(mock_url() + "giveup" + std::to_string(i), [&, i](HttpMulti::Result&& r) { results[i] = std::move(r); });
+    while (sched.poll(100) > 0) {}
+
+    size_t failed = 0;
+    for (const auto& r : results) {
+        if (r.ok()) continue;
+        ++failed;
+        EXPECT_TRUE(r.status == 429 || r.status == 503) << r.status;   // 마지막 응답이 그대로 온다
+    }
+    const RequestScheduler::Stats st = sched.stats();
+    EXPECT_GT(failed, 0u);
+    EXPECT_EQ(st.failed, failed);
+    EXPECT_EQ(st.retries, 0u);
+    EXPECT_EQ(st.sent, (uint64_t)n);
+}
+
+TEST(RequestScheduler, DeadlineBudgetStopsRetrying) {
+    REQUIRE_MOCK();
+    HttpMulti http(HttpMulti::Options{ 4 });
+
+    RequestScheduler::Options opt;
+    opt.rate_per_sec = 0;
+    opt.max_retries = 10;
+    opt.backoff_base_ms = 2000;      // 첫 재시도 전에 시한이 끝나도록
+    opt.backoff_cap_ms = 2000;
+    opt.batch_budget_ms = 300;
+    RequestScheduler sched(http, opt);
+
+    const int n = 16;
+    std::vector<HttpMulti::Result> results(n);
+    for (int i = 0; i < n; ++i)
+        sched.submit(mock_url() + "budget" + std::to_string(i), [&, i](HttpMulti::Result&& r) { results[i] = std::move(r); });
+    while (sched.poll(100) > 0) {}
+
+    const RequestScheduler::Stats st = sched.stats();
+    EXPECT_GT(st.expired, 0u);
+    size_t expired = 0;
+    for (const auto& r : results) expired += r.error == "deadline budget exhausted";
+    EXPECT_EQ(expired, st.expired);
+}
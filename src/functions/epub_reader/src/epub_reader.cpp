@@ -1,15 +1,27 @@
 #include <zip.h>
 #include <pugixml.hpp>
 #include "epub_reader.hpp"
+#include "mmap_file.hpp"
+#include "stored_entries.hpp"
+#include "text_collector.hpp"
+#include "xhtml_scanner.hpp"
+#include <atomic>
+#include <cstdlib>
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include <stdexcept>
 #include <algorithm>
 #include <fstream>
-
-// 디버그용
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <iomanip>
+#include <sstream>
 #include <filesystem>
 
 // ---- zip에서 파일 읽기 ----
@@ -32,6 +44,28 @@ static std::string read_zip_entry(zip_t* z, const std::string& name) {
     return buf;
 }
 
+// ---- zip 엔트리를 재사용 버퍼에 바로 풀기 (반환: 엔트리 크기) ----
+// buf 는 모자랄 때만 키우고 줄이지 않는다. grew: 키웠으면 true
+static size_t read_zip_entry_into(zip_t* z, const std::string& name, std::vector<char>& buf, bool& grew) {
+    zip_stat_t st;
+    if (zip_stat(z, name.c_str(), 0, &st) != 0)
+        throw std::runtime_error("zip_stat failed: " + name);
+
+    const size_t size = static_cast<size_t>(st.size);
+    grew = buf.size() < size;
+    if (grew) buf.resize(size);
+
+    zip_file_t* f = zip_fopen(z, name.c_str(), 0);
+    if (!f)
+        throw std::runtime_error("zip_fopen failed: " + name);
+    zip_int64_t n = zip_fread(f, buf.data(), st.size);
+    zip_fclose(f);
+
+    if (n < 0 || n != static_cast<zip_int64_t>(st.size))
+        throw std::runtime_error("zip_fread incomplete: " + name);
+    return size;
+}
+
 // ---- 경로 유틸 ----
 static std::string dirname_of(const std::string& p) {
     auto pos = p.find_last_of("/\\");
@@ -76,147 +110,454 @@ static std::string join_path(const std::string& base, const std::string& rel) {
     return res;
 }
 
-// ---- XHTML 텍스트 추출 (pugixml로 단순 텍스트만) ----
-// script/style 등은 스킵
-static bool is_hidden_tag(const char* name) {
-    // 소문자 비교 가정 (pugi는 원문 그대로 반환)
-    return std::string(name) == "script" || std::string(name) == "style";
+// ---- EPUB 열기 ----
+// 파일은 호출한 쪽에서 한 번 mmap 해 두고, libzip 에는 그 메모리를 zip_source_buffer 로 넘긴다
+// → 중앙 디렉터리 파싱과 압축 해제가 stdio/read 호출 없이 매핑에서 바로 (NFS 에 있는 책 묶음에서 차이가 큼)
+// zip_t 는 스레드마다 따로 열어야 하지만 매핑은 같이 쓴다 (읽기 전용)
+static zip_t* open_epub(const MappedFile& map) {
+    zip_error_t ze;
+    zip_error_init(&ze);
+    zip_source_t* src = zip_source_buffer_create(map.data(), map.size(), 0, &ze);
+    zip_t* z = src ? zip_open_from_source(src, ZIP_RDONLY, &ze) : nullptr;
+    if (!z) {
+        if (src) zip_source_free(src);   // 열기에 실패하면 source 는 호출한 쪽 소유
+        std::string msg = "zip_open failed: " + std::string(zip_error_strerror(&ze));
+        zip_error_fini(&ze);
+        throw std::runtime_error(msg);
+    }
+    zip_error_fini(&ze);
+    return z;
 }
 
-static void collect_text_recursive(const pugi::xml_node& node, std::string& out) {
-    // 텍스트 노드
-    if (node.type() == pugi::node_pcdata || node.type() == pugi::node_cdata) {
-        out.append(node.value());
-        return;
+// ---- 매핑한 EPUB 하나 (워커들이 같이 읽음, zip_t 보다 오래 살아야 함) ----
+struct EpubImage {
+    MappedFile map;
+    StoredEntries stored;
+    explicit EpubImage(const std::string& epub_path)
+        : map(std::filesystem::u8path(epub_path)), stored(index_stored_entries(map.data(), map.size())) {}
+};
+
+// ---- mimetype / container.xml / OPF → spine 순서의 zip 엔트리 경로 목록 ----
+static std::vector<std::string> read_spine_entries(zip_t* z) {
+    std::string mimetype = read_zip_entry(z, "mimetype");
+    while (!mimetype.empty() && (mimetype.back() == '\n' || mimetype.back() == '\r'))
+        mimetype.pop_back();
+
+    if (mimetype != "application/epub+zip") {
+        std::cerr << "[warn] unexpected mimetype!\n";
     }
-    // 엘리먼트
-    if (node.type() == pugi::node_element) {
-        const char* nm = node.name();
-        if (nm && is_hidden_tag(nm)) return; // skip script/style
 
-        // 자식 순회
-        for (pugi::xml_node ch = node.first_child(); ch; ch = ch.next_sibling()) {
-            collect_text_recursive(ch, out);
-        }
-        // 블록성 태그 뒤에 공백 한 칸 정도 추가해서 단어 붙음 방지 (단순 처리)
-        static const char* blockish[] = {
-            "p","div","h1","h2","h3","h4","h5","h6","li","ul","ol","section","article","br"
-        };
-        if (nm) {
-            for (auto b : blockish) {
-                if (std::string(nm) == b) {
-                    out.push_back(' ');
-                    break;
-                }
-            }
-        }
-        return;
+    // container.xml → OPF path
+    std::string container_xml = read_zip_entry(z, "META-INF/container.xml");
+    pugi::xml_document doc;
+    if (!doc.load_string(container_xml.c_str()))
+        throw std::runtime_error("Failed to parse container.xml");
+    auto rootfile = doc.select_node("/container/rootfiles/rootfile");
+    if (!rootfile)
+        throw std::runtime_error("No <rootfile> element");
+    std::string opf_path = rootfile.node().attribute("full-path").as_string();
+
+    // OPF 읽기
+    std::string opf_content = read_zip_entry(z, opf_path);
+    pugi::xml_document opfdoc;
+    if (!opfdoc.load_string(opf_content.c_str()))
+        throw std::runtime_error("Failed to parse OPF");
+
+    // manifest / spine 파싱
+    std::unordered_map<std::string, std::string> id_to_href;
+    pugi::xml_node manifest = opfdoc.child("package").child("manifest");
+    for (pugi::xml_node item = manifest.child("item"); item; item = item.next_sibling("item")) {
+        std::string id   = item.attribute("id").as_string();
+        std::string href = item.attribute("href").as_string();
+        if (!id.empty() && !href.empty()) id_to_href[id] = href;
     }
-    // 그 외 노드 타입도 자식 순회
-    for (pugi::xml_node ch = node.first_child(); ch; ch = ch.next_sibling()) {
-        collect_text_recursive(ch, out);
+
+    std::string opf_dir = dirname_of(opf_path);
+    std::vector<std::string> entries;
+    pugi::xml_node spine = opfdoc.child("package").child("spine");
+    for (pugi::xml_node ir = spine.child("itemref"); ir; ir = ir.next_sibling("itemref")) {
+        std::string idref = ir.attribute("idref").as_string();
+        auto it = id_to_href.find(idref);
+        if (it != id_to_href.end()) entries.push_back(join_path(opf_dir, it->second));
     }
+    return entries;
 }
 
+// ---- 챕터 처리 시간 + 메모리 통계 누적 (inflate / parse / 텍스트 수집) ----
+struct ChapterTiming {
+    double inflate_ms = 0, parse_ms = 0, collect_ms = 0;
+    uint64_t docs = 0;
+    uint64_t xml_bytes = 0;      // 압축 해제한 XHTML 크기
+    uint64_t copied_bytes = 0;   // 그 뒤로 복사한 바이트 (파서 입력 복사 + 텍스트 수집)
+    uint64_t allocs = 0;         // 힙 할당 (압축 해제 버퍼 + 텍스트 버퍼 증가 + pugixml 내부)
+    uint64_t mapped = 0;         // 무압축이라 풀지 않고 매핑을 그대로 읽은 문서
+    ChapterTiming& operator+=(const ChapterTiming& o) {
+        inflate_ms += o.inflate_ms; parse_ms += o.parse_ms; collect_ms += o.collect_ms;
+        docs += o.docs; xml_bytes += o.xml_bytes; copied_bytes += o.copied_bytes; allocs += o.allocs;
+        mapped += o.mapped;
+        return *this;
+    }
+};
+
+// ---- pugixml 내부 할당 수 (스레드별로 세서 워커끼리 섞이지 않게) ----
+static thread_local uint64_t t_pugi_allocs = 0;
 
-std::string extract_epub_text(const std::string& epub_path) {
-    int errcode = 0;
+static void* counting_alloc(size_t n) {
+    ++t_pugi_allocs;
+    return std::malloc(n);
+}
 
-    // // 디버그용
-    // std::cerr << "[cwd] " << std::filesystem::current_path() << "\n";
-    // std::cerr << "[try] " << std::filesystem::absolute(epub_path) << "\n";
+static void counting_free(void* p) {
+    std::free(p);
+}
 
-    zip_t* z = zip_open(epub_path.c_str(), ZIP_RDONLY, &errcode);
-    if (!z) {
-        zip_error_t ze;
-        zip_error_init_with_code(&ze, errcode);
-        std::string msg = "zip_open failed: " + std::string(zip_error_strerror(&ze));
-        zip_error_fini(&ze);
-        throw std::runtime_error(msg);
+// 어떤 문서도 만들기 전에 한 번만 (할당/해제 함수가 섞이지 않도록)
+static void install_pugi_alloc_counter() {
+    static const bool done = [] {
+        pugi::set_memory_management_functions(counting_alloc, counting_free);
+        return true;
+    }();
+    (void)done;
+}
+
+// ---- 챕터 파싱에 워커마다 재사용하는 상태 ----
+// 압축 해제 버퍼를 그대로 파서에 넘기고(load_buffer_inplace, 복사 없음) 문서 객체도 챕터마다 다시 쓴다.
+// 텍스트 노드 값은 이 버퍼 안을 가리키므로 다음 챕터를 풀기 전에 텍스트 수집을 끝내야 한다.
+// 스트리밍 스캐너는 입력을 읽기만 하므로 무압축 엔트리는 매핑을 그대로 받는다 (열린 태그 스택만 재사용)
+struct ChapterScratch {
+    std::vector<char> xml;
+    pugi::xml_document doc;
+    XhtmlScanner scanner;
+};
+
+static std::atomic<XhtmlParser> g_xhtml_parser{ XhtmlParser::kDom };
+
+void set_xhtml_parser(XhtmlParser parser) { g_xhtml_parser = parser; }
+
+// 본문 텍스트만 필요: 주석/PI/DOCTYPE/선언 노드는 만들지 않고, 줄끝 정규화와 속성 정규화도 생략
+// (공백은 토크나이저/squish 가 처리). 엔티티(&amp; &#8217; 등)와 CDATA 는 텍스트라서 유지
+static const unsigned kChapterParseFlags = pugi::parse_cdata | pugi::parse_escapes;
+
+using Clock = std::chrono::steady_clock;
+static double ms_since(Clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+// ---- XHTML → 텍스트: pugixml DOM ----
+// xml 은 scratch.xml 에 풀어 둔 것 또는 매핑 안의 무압축 엔트리.
+// load_buffer_inplace 는 입력을 고쳐 쓰므로 매핑(읽기 전용)이면 scratch.xml 로 한 번 복사
+static bool dom_text(ChapterScratch& scratch, std::string_view xml, std::string& out, ChapterTiming& tm) {
+    const size_t n = xml.size();
+    if (xml.data() != scratch.xml.data()) {
+        if (scratch.xml.size() < n) {
+            scratch.xml.resize(n);
+            ++tm.allocs;
+        }
+        std::copy(xml.begin(), xml.end(), scratch.xml.begin());
+        tm.copied_bytes += n;
     }
+    const uint64_t pugi_allocs0 = t_pugi_allocs;
+    auto t1 = Clock::now();
+    // 버퍼를 제자리에서 파싱 (UTF-8 이면 복사/변환 없음, 문서 초기화도 여기서)
+    bool ok = n > 0 && scratch.doc.load_buffer_inplace(scratch.xml.data(), n, kChapterParseFlags, pugi::encoding_auto);
+    auto t2 = Clock::now();
+    tm.parse_ms += std::chrono::duration<double, std::milli>(t2 - t1).count();
+    tm.allocs += t_pugi_allocs - pugi_allocs0;
+    if (!ok) return false;
 
-    std::string all_text;
+    const size_t cap = out.capacity();
+    pugi::xml_node html = scratch.doc.child("html");
+    pugi::xml_node root = html ? html.child("body") : pugi::xml_node(scratch.doc);
+    collect_text(root, out);
+    tm.collect_ms += ms_since(t2);
+    tm.copied_bytes += out.size();
+    if (out.capacity() != cap) ++tm.allocs;
+    return true;
+}
+
+// ---- 같은 입력 → 텍스트: 스트리밍 스캐너 (트리 없음, 입력은 읽기만) ----
+// 빈 입력은 DOM 처럼 실패(kMalformed). kNotUtf8 이면 out 은 그대로
+static XhtmlScanner::Result scan_text(ChapterScratch& scratch, std::string_view xml, std::string& out,
+                                      ChapterTiming& tm) {
+    if (xml.empty()) return XhtmlScanner::Result::kMalformed;
+    const size_t cap = out.capacity();
+    auto t1 = Clock::now();
+    const auto r = scratch.scanner.scan(xml.data(), xml.size(), out);
+    if (r == XhtmlScanner::Result::kNotUtf8) return r;
+    // 파싱과 텍스트 수집이 한 번에 끝나므로 전부 parse 시간으로
+    tm.parse_ms += ms_since(t1);
+    tm.copied_bytes += out.size();
+    if (out.capacity() != cap) ++tm.allocs;
+    return r;
+}
+
+// UTF-8 이 아닌 문서는 인코딩 변환이 필요하므로 DOM 경로로 넘긴다
+static bool stream_text(ChapterScratch& scratch, std::string_view xml, std::string& out, ChapterTiming& tm) {
+    const auto r = scan_text(scratch, xml, out, tm);
+    if (r == XhtmlScanner::Result::kNotUtf8) return dom_text(scratch, xml, out, tm);
+    return r == XhtmlScanner::Result::kOk;
+}
+
+// ---- 챕터 원문: 무압축 엔트리는 매핑 안을 그대로, 아니면 scratch.xml 에 풀어서 ----
+static std::string_view chapter_xml(zip_t* z, const EpubImage& epub, const std::string& entry,
+                                    ChapterScratch& scratch, ChapterTiming& tm) {
+    ++tm.docs;
+    auto it = epub.stored.find(entry);
+    if (it != epub.stored.end()) {
+        ++tm.mapped;
+        tm.xml_bytes += it->second.size();
+        return it->second;
+    }
+    auto t0 = Clock::now();
+    bool grew = false;
+    const size_t n = read_zip_entry_into(z, entry, scratch.xml, grew);
+    tm.inflate_ms += ms_since(t0);
+    tm.xml_bytes += n;
+    if (grew) ++tm.allocs;
+    return std::string_view(scratch.xml.data(), n);
+}
+
+// ---- spine 문서 하나 → 텍스트 (out 은 비우고 다시 채움, capacity 재사용) ----
+static bool chapter_text(zip_t* z, const EpubImage& epub, const std::string& entry, std::string& out,
+                         ChapterScratch& scratch, ChapterTiming& tm) {
+    out.clear();
     try {
-        std::string mimetype = read_zip_entry(z, "mimetype");
-        while (!mimetype.empty() && (mimetype.back() == '\n' || mimetype.back() == '\r'))
-            mimetype.pop_back();
+        const std::string_view xml = chapter_xml(z, epub, entry, scratch, tm);
+        if (g_xhtml_parser.load(std::memory_order_relaxed) == XhtmlParser::kStream)
+            return stream_text(scratch, xml, out, tm);
+        return dom_text(scratch, xml, out, tm);
+    } catch (...) {
+        // 무시하고 계속
+        return false;
+    }
+}
 
-        if (mimetype != "application/epub+zip") {
-            std::cerr << "[warn] unexpected mimetype!\n";
-        }
+// ---- 병렬 모드: 워커마다 zip_t 핸들을 따로 열고 챕터를 나눠 처리 ----
+// 결과는 spine 순서대로 sink 에 전달. 앞서 처리해 두는 챕터 수는 jobs*2 로 제한(메모리 상한).
+static void extract_parallel(const EpubImage& epub,
+                             const std::vector<std::string>& entries,
+                             const TextSink& sink, unsigned jobs, ChapterTiming& total)
+{
+    const size_t n = entries.size();
+    const size_t window = size_t(jobs) * 2;
 
-        // container.xml → OPF path
-        std::string container_xml = read_zip_entry(z, "META-INF/container.xml");
-        pugi::xml_document doc;
-        if (!doc.load_string(container_xml.c_str()))
-            throw std::runtime_error("Failed to parse container.xml");
-        auto rootfile = doc.select_node("/container/rootfiles/rootfile");
-        if (!rootfile)
-            throw std::runtime_error("No <rootfile> element");
-        std::string opf_path = rootfile.node().attribute("full-path").as_string();
-
-        // OPF 읽기
-        std::string opf_content = read_zip_entry(z, opf_path);
-        pugi::xml_document opfdoc;
-        if (!opfdoc.load_string(opf_content.c_str()))
-            throw std::runtime_error("Failed to parse OPF");
-
-        // manifest / spine 파싱
-        std::unordered_map<std::string, std::string> id_to_href;
-        pugi::xml_node manifest = opfdoc.child("package").child("manifest");
-        for (pugi::xml_node item = manifest.child("item"); item; item = item.next_sibling("item")) {
-            std::string id   = item.attribute("id").as_string();
-            std::string href = item.attribute("href").as_string();
-            if (!id.empty() && !href.empty()) id_to_href[id] = href;
-        }
+    std::vector<std::string> texts(n);
+    std::vector<char> ready(n, 0);
+    size_t next_task = 0, next_emit = 0;
+    bool abort = false;
+    std::exception_ptr err;
+    std::mutex mu;
+    std::condition_variable cv;
+
+    auto fail = [&](std::exception_ptr e) {
+        std::lock_guard<std::mutex> lk(mu);
+        if (!err) err = e;
+        abort = true;
+        cv.notify_all();
+    };
+
+    auto worker = [&]() {
+        zip_t* wz = nullptr;
+        try { wz = open_epub(epub.map); }
+        catch (...) { fail(std::current_exception()); return; }
 
-        std::vector<std::string> spine_hrefs;
-        pugi::xml_node spine = opfdoc.child("package").child("spine");
-        for (pugi::xml_node ir = spine.child("itemref"); ir; ir = ir.next_sibling("itemref")) {
-            std::string idref = ir.attribute("idref").as_string();
-            auto it = id_to_href.find(idref);
-            if (it != id_to_href.end()) spine_hrefs.push_back(it->second);
+        ChapterTiming local;
+        ChapterScratch scratch;
+        for (;;) {
+            size_t idx;
+            {
+                std::unique_lock<std::mutex> lk(mu);
+                cv.wait(lk, [&]{ return abort || next_task >= n || next_task < next_emit + window; });
+                if (abort || next_task >= n) break;
+                idx = next_task++;
+            }
+            std::string text;
+            chapter_text(wz, epub, entries[idx], text, scratch, local);
+            {
+                std::lock_guard<std::mutex> lk(mu);
+                texts[idx] = std::move(text);
+                ready[idx] = 1;
+            }
+            cv.notify_all();
         }
+        zip_close(wz);
+
+        std::lock_guard<std::mutex> lk(mu);
+        total += local;
+    };
 
-        // spine 순서대로 모든 텍스트 수집
-        std::string opf_dir = dirname_of(opf_path);
-        for (const auto& rel : spine_hrefs) {
-            std::string entry = join_path(opf_dir, rel);
-            try {
-                std::string xhtml = read_zip_entry(z, entry);
-                pugi::xml_document hdoc;
-                if (!hdoc.load_string(xhtml.c_str())) continue;
-                pugi::xml_node html = hdoc.child("html");
-                pugi::xml_node root = html ? html.child("body") : hdoc;
-                collect_text_recursive(root, all_text);
-            } catch (...) {
-                // 무시하고 계속
+    std::vector<std::thread> pool;
+    pool.reserve(jobs);
+    for (unsigned j = 0; j < jobs; ++j) pool.emplace_back(worker);
+
+    // 메인 스레드: spine 순서대로 이어 붙이기
+    try {
+        for (;;) {
+            std::string text;
+            {
+                std::unique_lock<std::mutex> lk(mu);
+                cv.wait(lk, [&]{ return abort || next_emit >= n || ready[next_emit]; });
+                if (abort || next_emit >= n) break;
+                text = std::move(texts[next_emit]);
+                ++next_emit;
             }
+            cv.notify_all();
+            if (!text.empty()) sink(text.data(), text.size(), next_emit - 1);
         }
+    } catch (...) {
+        fail(std::current_exception());
+    }
 
+    for (auto& t : pool) t.join();
+    if (err) std::rethrow_exception(err);
+}
+
+void extract_epub_text_stream(const std::string& epub_path, const TextSink& sink, unsigned jobs) {
+    auto t0 = Clock::now();
+    install_pugi_alloc_counter();
+
+    const EpubImage epub(epub_path);
+    zip_t* z = open_epub(epub.map);
+    std::vector<std::string> entries;
+    try {
+        entries = read_spine_entries(z);
+    } catch (...) {
         zip_close(z);
+        throw;  // 예외 다시 던짐
+    }
 
-        // 연속 공백 압축
-        auto squish = [](std::string& s){
-            bool prev_space=false; size_t w=0;
-            for (size_t i=0;i<s.size();++i){
-                char c = s[i];
-                bool is_space = (c==' ' || c=='\n' || c=='\r' || c=='\t');
-                if (is_space) {
-                    if (!prev_space) s[w++] = ' ';
-                    prev_space = true;
-                } else {
-                    s[w++] = c; prev_space = false;
-                }
+    if (jobs == 0) jobs = std::max(1u, std::thread::hardware_concurrency());
+    if (jobs > entries.size()) jobs = (unsigned)std::max<size_t>(1, entries.size());
+
+    ChapterTiming tm;
+    if (jobs <= 1) {
+        try {
+            // 챕터 하나 분량만 메모리에 유지 → 전체 책 버퍼 없음
+            std::string chapter;
+            ChapterScratch scratch;
+            for (size_t i = 0; i < entries.size(); ++i) {
+                if (chapter_text(z, epub, entries[i], chapter, scratch, tm) && !chapter.empty())
+                    sink(chapter.data(), chapter.size(), i);
             }
-            s.resize(w);
-        };
-        squish(all_text);
+            zip_close(z);
+        }
+        catch (...) {
+            zip_close(z);
+            throw;
+        }
+    } else {
+        zip_close(z);
+        extract_parallel(epub, entries, sink, jobs, tm);
+    }
 
-        return all_text;
+    // 시간 분해: inflate/parse/text 는 워커 합계, wall 은 실제 경과
+    const double wall = ms_since(t0);
+    const double work = tm.inflate_ms + tm.parse_ms + tm.collect_ms;
+    // 배치 모드에서 여러 책이 동시에 찍으므로 한 줄을 만들어 한 번에 출력
+    std::ostringstream line;
+    line << std::fixed << std::setprecision(1)
+         << "[time] spine " << entries.size() << " docs, jobs=" << jobs
+         << ", xhtml=" << (g_xhtml_parser.load() == XhtmlParser::kStream ? "stream" : "dom")
+         << " | inflate " << tm.inflate_ms << " ms, parse " << tm.parse_ms
+         << " ms, text " << tm.collect_ms << " ms (sum)"
+         << " | wall " << wall << " ms (x" << std::setprecision(2)
+         << (wall > 0 ? work / wall : 0.0) << ")";
+    // 챕터당 메모리: 압축 해제 크기 대비 복사한 바이트, 힙 할당 수 (버퍼/문서 재사용 효과 확인용)
+    if (tm.docs) {
+        line << std::setprecision(1)
+             << " | per doc: " << tm.xml_bytes / 1024.0 / tm.docs << " KB xhtml, "
+             << tm.copied_bytes / 1024.0 / tm.docs << " KB copied, "
+             << double(tm.allocs) / tm.docs << " allocs";
+        if (tm.mapped) line << ", " << tm.mapped << " stored (zero-copy)";
     }
-    catch (...) {
+    line << "\n";
+    std::cout << line.str() << std::flush;
+}
+
+std::string extract_epub_text(const std::string& epub_path, unsigned jobs,
+                              std::vector<std::pair<size_t, uint32_t>>* chapters) {
+    // 연속 공백 압축: 챕터를 붙일 때마다 새로 붙은 부분만 (챕터 경계를 넘어 상태 유지)
+    bool prev_space = false;
+    auto squish_from = [&prev_space](std::string& s, size_t from){
+        size_t w = from;
+        for (size_t i=from;i<s.size();++i){
+            char c = s[i];
+            bool is_space = (c==' ' || c=='\n' || c=='\r' || c=='\t');
+            if (is_space) {
+                if (!prev_space) s[w++] = ' ';
+                prev_space = true;
+            } else {
+                s[w++] = c; prev_space = false;
+            }
+        }
+        s.resize(w);
+    };
+
+    // spine 순서대로 모든 텍스트 수집
+    std::string all_text;
+    extract_epub_text_stream(epub_path, [&](const char* data, size_t n, size_t spine_index) {
+        const size_t from = all_text.size();
+        if (chapters) chapters->emplace_back(from, (uint32_t)spine_index);
+        all_text.append(data, n);
+        squish_from(all_text, from);
+    }, jobs);
+
+    return all_text;
+}
+
+bool verify_xhtml_parser(const std::string& epub_path) {
+    std::cout << "[*] Verifying streaming XHTML scanner against pugixml DOM...\n";
+    install_pugi_alloc_counter();
+
+    const EpubImage epub(epub_path);
+    zip_t* z = open_epub(epub.map);
+    std::vector<std::string> entries;
+    ChapterTiming dom, stream;
+    size_t mismatches = 0, not_utf8 = 0;
+    try {
+        entries = read_spine_entries(z);
+        ChapterScratch scratch;
+        std::string a, b;
+        for (const auto& entry : entries) {
+            const std::string_view xml = chapter_xml(z, epub, entry, scratch, stream);
+            // 스캐너는 입력을 바꾸지 않으므로 먼저, DOM(load_buffer_inplace)은 버퍼를 고쳐 쓰므로 나중에 한 번만.
+            // stream_text 의 kNotUtf8 → dom_text 대체 경로도 버퍼를 고쳐 쓰므로 여기서는 스캐너만 직접 부른다
+            a.clear();
+            b.clear();
+            const auto r = scan_text(scratch, xml, b, stream);
+            const bool ok_dom = dom_text(scratch, xml, a, dom);
+            ++dom.docs;
+            dom.xml_bytes += xml.size();
+            if (r == XhtmlScanner::Result::kNotUtf8) {
+                ++not_utf8;   // 스트리밍 모드도 DOM 으로 처리하는 문서 → 비교할 것 없음
+                continue;
+            }
+            const bool ok_stream = r == XhtmlScanner::Result::kOk;
+            if (ok_dom == ok_stream && a == b) continue;
+
+            if (++mismatches <= 5) {
+                const auto diff = std::mismatch(a.begin(), a.end(), b.begin(), b.end());
+                std::cout << "    - mismatch: " << entry << " (dom " << (ok_dom ? "ok" : "failed") << " "
+                          << a.size() << " B, stream " << (ok_stream ? "ok" : "failed") << " " << b.size()
+                          << " B, first diff at " << (diff.first - a.begin()) << ")\n";
+            }
+        }
         zip_close(z);
-        throw;  // 예외 다시 던짐
+    } catch (...) {
+        zip_close(z);
+        throw;
     }
-}
\ No newline at end of file
+
+    auto report = [](const char* name, const ChapterTiming& tm) {
+        const double ms = tm.parse_ms + tm.collect_ms;
+        std::cout << "    - " << name << tm.docs << " docs, " << std::fixed << std::setprecision(1)
+                  << tm.copied_bytes / 1024.0 << " KB text (" << ms << " ms, "
+                  << (ms > 0 ? tm.xml_bytes / 1048576.0 / (ms / 1000.0) : 0.0) << " MB/s, "
+                  << tm.allocs << " allocs)\n";
+    };
+    report("dom:    ", dom);
+    report("stream: ", stream);
+    if (not_utf8) std::cout << "    - " << not_utf8 << " non-UTF-8 docs (stream mode hands them to the DOM)\n";
+    std::cout << (mismatches == 0 ? "[✓] identical output\n" : "[✗] OUTPUT MISMATCH\n");
+    return mismatches == 0;
+}
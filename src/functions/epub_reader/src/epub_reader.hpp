@@ -1,6 +1,35 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <string>
+#include <utility>
+#include <vector>
 
 // epub 파일의 본문 전체 텍스트를 반환
+// jobs: 챕터 inflate/parse 병렬 워커 수 (1=순차, 0=코어 수)
+// chapters: (선택) 반환 텍스트 안에서 각 spine 문서가 시작하는 (오프셋, spine 인덱스)
 // 오류 시 예외(std::runtime_error) 발생
-std::string extract_epub_text(const std::string& epub_path);
+std::string extract_epub_text(const std::string& epub_path, unsigned jobs = 1,
+                              std::vector<std::pair<size_t, uint32_t>>* chapters = nullptr);
+
+// 텍스트 조각을 받는 콜백: sink(data, size, spine 인덱스)
+using TextSink = std::function<void(const char* data, size_t n, size_t spine_index)>;
+
+// 스트리밍 모드: spine 순서대로 문서 하나씩 텍스트를 sink 로 넘긴다
+// - 전체 책 버퍼를 만들지 않음 (최대 메모리 ≈ 가장 큰 XHTML 엔트리 하나)
+// - EPUB 파일은 한 번 mmap 해서 libzip 에 메모리 소스로 넘김, 무압축 엔트리는 매핑을 복사 없이 바로 읽음
+// - 공백 압축(squish)은 하지 않음 (토크나이저 결과에는 영향 없음)
+// - jobs > 1 이면 워커마다 zip 핸들을 따로 열어 병렬 처리, 순서는 spine 순서 유지
+// 오류 시 예외(std::runtime_error) 발생
+void extract_epub_text_stream(const std::string& epub_path, const TextSink& sink, unsigned jobs = 1);
+
+// 챕터 XHTML → 텍스트 방식
+// kDom:    pugixml 로 트리를 만든 뒤 순회 (기본)
+// kStream: DOM 없이 한 번 훑는 스캐너 (메모리 적고 빠름. UTF-8 이 아닌 문서는 자동으로 kDom)
+//          결과는 kDom 과 바이트 단위로 같아야 한다 (epub_reader_test, --check-xhtml)
+enum class XhtmlParser { kDom, kStream };
+void set_xhtml_parser(XhtmlParser parser);
+
+// spine 문서마다 두 방식을 모두 돌려 텍스트가 바이트 단위로 같은지 비교 + 속도/할당 출력, 같으면 true
+bool verify_xhtml_parser(const std::string& epub_path);
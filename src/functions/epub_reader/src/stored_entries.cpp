@@ -0,0 +1,45 @@
+#include "stored_entries.hpp"
+
+#include <cstdint>
+
+namespace {
+
+uint32_t le16(const unsigned char* p) { return uint32_t(p[0]) | uint32_t(p[1]) << 8; }
+uint32_t le32(const unsigned char* p) { return le16(p) | le16(p + 2) << 16; }
+
+} // namespace
+
+StoredEntries index_stored_entries(const char* data, size_t size) {
+    StoredEntries stored;
+    const auto* base = reinterpret_cast<const unsigned char*>(data);
+    if (size < 22) return stored;
+
+    // 끝에서부터 EOCD(PK\5\6) 찾기 (뒤에 주석이 최대 64KB)
+    size_t eocd = size - 22;
+    const size_t lowest = size > 22 + 0xFFFF ? size - 22 - 0xFFFF : 0;
+    while (le32(base + eocd) != 0x06054b50) {
+        if (eocd == lowest) return stored;
+        --eocd;
+    }
+    const size_t count = le16(base + eocd + 10);
+    size_t pos = le32(base + eocd + 16);   // ZIP64 면 0xFFFFFFFF → 아래 경계 검사에서 걸러짐
+
+    for (size_t i = 0; i < count; ++i) {
+        if (pos + 46 > size || le32(base + pos) != 0x02014b50) break;
+        const unsigned char* cd = base + pos;
+        const uint32_t flags = le16(cd + 8), method = le16(cd + 10);
+        const uint32_t csize = le32(cd + 20), usize = le32(cd + 24);
+        const size_t name_len = le16(cd + 28), extra_len = le16(cd + 30), comment_len = le16(cd + 32);
+        const size_t local = le32(cd + 42);
+        if (pos + 46 + name_len > size) break;
+        const std::string name(reinterpret_cast<const char*>(cd + 46), name_len);
+        pos += 46 + name_len + extra_len + comment_len;
+
+        if (method != 0 || (flags & 1) || csize != usize || usize == 0xFFFFFFFF || local == 0xFFFFFFFF) continue;
+        if (local + 30 > size || le32(base + local) != 0x04034b50) continue;
+        const size_t at = local + 30 + le16(base + local + 26) + le16(base + local + 28);
+        if (at + usize > size) continue;
+        stored.emplace(name, std::string_view(data + at, usize));
+    }
+    return stored;
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// ---- 무압축(stored) 엔트리 → 매핑 안의 위치 ----
+// 중앙 디렉터리를 직접 훑어서 method 0 + 암호화 없음인 엔트리는 libzip 을 거치지 않고 매핑을 그대로 읽는다 (복사 0).
+// ZIP64 값이 필요한 엔트리나 헤더가 이상한 엔트리는 목록에서 빼고 libzip 경로로 둔다
+// (EOCD 를 못 찾거나 중앙 디렉터리가 깨졌으면 거기까지만 → 나머지도 libzip 경로)
+using StoredEntries = std::unordered_map<std::string, std::string_view>;
+
+// data[0, size) 는 zip 파일 전체. 값은 data 안을 가리키므로 data 보다 오래 쓰면 안 됨
+StoredEntries index_stored_entries(const char* data, size_t size);
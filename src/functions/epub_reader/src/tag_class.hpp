@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+// ---- 텍스트 추출용 XHTML 태그 분류 (DOM 경로와 스트리밍 스캐너가 같이 씀) ----
+// kHidden: 하위 전체 생략 (script, style)
+// kBlock:  닫힌 뒤 ' ' 한 칸 (p, div, h1~h6, li, ul, ol, section, article, br) → 단어 붙음 방지
+// kInline: 그 외
+// 접두사(xhtml:p → p)는 떼고 ASCII 대소문자는 구분하지 않는다.
+// 길이 + 첫 글자 switch 라서 할당/문자열 생성 없음, constexpr
+enum class TagClass : uint8_t { kInline, kBlock, kHidden };
+
+namespace tag_class_detail {
+
+constexpr char lower(char c) { return (c >= 'A' && c <= 'Z') ? char(c + ('a' - 'A')) : c; }
+
+// name 과 소문자 리터럴 lit 이 대소문자 무시하고 같은지 (길이는 호출 전에 switch 로 맞춤)
+constexpr bool same(std::string_view name, std::string_view lit) {
+    for (size_t i = 0; i < lit.size(); ++i)
+        if (lower(name[i]) != lit[i]) return false;
+    return true;
+}
+
+} // namespace tag_class_detail
+
+constexpr TagClass classify_tag(std::string_view name) {
+    using tag_class_detail::lower;
+    using tag_class_detail::same;
+    const size_t colon = name.rfind(':');
+    if (colon != std::string_view::npos) name.remove_prefix(colon + 1);
+
+    switch (name.size()) {
+    case 1:
+        return lower(name[0]) == 'p' ? TagClass::kBlock : TagClass::kInline;
+    case 2: {
+        const char a = lower(name[0]), b = lower(name[1]);
+        if (a == 'h') return (b >= '1' && b <= '6') ? TagClass::kBlock : TagClass::kInline;
+        if ((a == 'l' && b == 'i') || (a == 'u' && b == 'l') || (a == 'o' && b == 'l') || (a == 'b' && b == 'r'))
+            return TagClass::kBlock;
+        return TagClass::kInline;
+    }
+    case 3:
+        return same(name, "div") ? TagClass::kBlock : TagClass::kInline;
+    case 5:
+        return same(name, "style") ? TagClass::kHidden : TagClass::kInline;
+    case 6:
+        return same(name, "script") ? TagClass::kHidden : TagClass::kInline;
+    case 7:
+        switch (lower(name[0])) {
+        case 's': return same(name, "section") ? TagClass::kBlock : TagClass::kInline;
+        case 'a': return same(name, "article") ? TagClass::kBlock : TagClass::kInline;
+        default:  return TagClass::kInline;
+        }
+    default:
+        return TagClass::kInline;
+    }
+}
+
+static_assert(classify_tag("p") == TagClass::kBlock && classify_tag("xhtml:H3") == TagClass::kBlock);
+static_assert(classify_tag("SCRIPT") == TagClass::kHidden && classify_tag("span") == TagClass::kInline);
@@ -0,0 +1,64 @@
+#include "text_collector.hpp"
+#include "tag_class.hpp"
+
+#include <vector>
+
+namespace {
+
+// 전위 순회에는 "자식 다 끝남" 콜백이 없으므로, 블록 엘리먼트 깊이를 쌓아 두었다가
+// 그 깊이 이하의 다음 노드(또는 끝)에 닿으면 ' ' 를 붙인다
+class TextCollector : public pugi::xml_tree_walker {
+public:
+    explicit TextCollector(std::string& out) : out_(out) {}
+
+    bool for_each(pugi::xml_node& node) override {
+        const int d = depth();
+        if (skip_below_ >= 0) {
+            if (d > skip_below_) return true;   // 숨김 엘리먼트 하위
+            skip_below_ = -1;
+        }
+        close_blocks(d);
+
+        switch (node.type()) {
+        case pugi::node_pcdata:
+        case pugi::node_cdata:
+            out_.append(node.value());
+            break;
+        case pugi::node_element:
+            switch (classify_tag(node.name())) {
+            case TagClass::kHidden: skip_below_ = d; break;
+            case TagClass::kBlock:  open_blocks_.push_back(d); break;
+            case TagClass::kInline: break;
+            }
+            break;
+        default:
+            break;
+        }
+        return true;
+    }
+
+    bool end(pugi::xml_node&) override {
+        close_blocks(0);
+        return true;
+    }
+
+private:
+    // depth d 인 노드에 왔으면 깊이 >= d 인 블록은 모두 닫힌 것
+    void close_blocks(int d) {
+        while (!open_blocks_.empty() && open_blocks_.back() >= d) {
+            out_.push_back(' ');
+            open_blocks_.pop_back();
+        }
+    }
+
+    std::string& out_;
+    std::vector<int> open_blocks_;   // 아직 닫히지 않은 블록 엘리먼트 깊이 (오름차순)
+    int skip_below_ = -1;            // 이 깊이의 숨김 엘리먼트 하위를 건너뛰는 중
+};
+
+} // namespace
+
+void collect_text(pugi::xml_node node, std::string& out) {
+    TextCollector collector(out);
+    node.traverse(collector);
+}
@@ -0,0 +1,9 @@
+#pragma once
+#include <pugixml.hpp>
+#include <string>
+
+// ---- pugixml DOM 에서 본문 텍스트만 뽑기 (DOM 경로의 collect_text) ----
+// node 의 하위 텍스트를 out 뒤에 붙인다 (node 자신은 body 또는 문서라서 분류하지 않음)
+// - pcdata/cdata 는 그대로, 태그 분류는 classify_tag (script/style 하위 생략, 블록성 태그가 닫히면 ' ' 하나)
+// - 재귀 대신 xml_tree_walker(전위 순회, 반복문)라서 깊게 중첩된 문서도 스택이 넘치지 않는다
+void collect_text(pugi::xml_node node, std::string& out);
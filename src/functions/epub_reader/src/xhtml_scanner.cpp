@@ -0,0 +1,286 @@
+#include "xhtml_scanner.hpp"
+#include "tag_class.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+// pugixml 의 ct_space / ct_start_symbol / ct_symbol 과 같은 분류 (0x80 이상 바이트는 이름 글자)
+inline bool is_ws(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+inline bool is_name_start(unsigned char c) {
+    return unsigned((c | 0x20) - 'a') < 26u || c == '_' || c == ':' || c >= 0x80;
+}
+inline bool is_name_char(unsigned char c) {
+    return is_name_start(c) || unsigned(c - '0') < 10u || c == '-' || c == '.';
+}
+
+inline bool starts_with(const char* p, const char* end, std::string_view lit) {
+    return size_t(end - p) >= lit.size() && std::memcmp(p, lit.data(), lit.size()) == 0;
+}
+
+// [p, end) 에서 lit 가 처음 나오는 위치 (없으면 nullptr)
+const char* find_lit(const char* p, const char* end, std::string_view lit) {
+    while (size_t(end - p) >= lit.size()) {
+        p = static_cast<const char*>(std::memchr(p, lit[0], size_t(end - p) - lit.size() + 1));
+        if (!p) return nullptr;
+        if (std::memcmp(p, lit.data(), lit.size()) == 0) return p;
+        ++p;
+    }
+    return nullptr;
+}
+
+const char* skip_ws(const char* p, const char* end) {
+    while (p < end && is_ws(*p)) ++p;
+    return p;
+}
+
+const char* skip_name(const char* p, const char* end) {
+    while (p < end && is_name_char((unsigned char)*p)) ++p;
+    return p;
+}
+
+// 코드 포인트 → UTF-8 (pugixml 의 utf8_writer 와 같이 범위 검사 없이 하위 비트만 씀)
+void append_utf8(std::string& out, uint32_t cp) {
+    if (cp < 0x80) {
+        out.push_back(char(cp));
+    } else if (cp < 0x800) {
+        out.push_back(char(0xC0 | (cp >> 6)));
+        out.push_back(char(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+        out.push_back(char(0xE0 | (cp >> 12)));
+        out.push_back(char(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(char(0x80 | (cp & 0x3F)));
+    } else {
+        out.push_back(char(uint8_t(0xF0 | (cp >> 18))));
+        out.push_back(char(0x80 | ((cp >> 12) & 0x3F)));
+        out.push_back(char(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(char(0x80 | (cp & 0x3F)));
+    }
+}
+
+// '&' 위치 p 의 엔티티 하나를 풀어 cp 에 넣고 다음 위치 반환. 풀 수 없으면 nullptr (원문 유지)
+const char* decode_entity(const char* p, const char* end, uint32_t& cp) {
+    const char* s = p + 1;
+    if (s < end && *s == '#') {
+        ++s;
+        const bool hex = s < end && *s == 'x';
+        if (hex) ++s;
+        if (s >= end || *s == ';') return nullptr;
+        cp = 0;
+        for (;; ++s) {
+            if (s >= end) return nullptr;
+            const unsigned char c = (unsigned char)*s;
+            if (c == ';') return s + 1;
+            if (unsigned(c - '0') < 10u) cp = cp * (hex ? 16 : 10) + (c - '0');
+            else if (hex && unsigned((c | 0x20) - 'a') < 6u) cp = cp * 16 + ((c | 0x20) - 'a' + 10);
+            else return nullptr;
+        }
+    }
+    static const struct { std::string_view name; char ch; } kNamed[] = {
+        { "amp;", '&' }, { "lt;", '<' }, { "gt;", '>' }, { "apos;", '\'' }, { "quot;", '"' },
+    };
+    for (const auto& e : kNamed) {
+        if (starts_with(s, end, e.name)) {
+            cp = (unsigned char)e.ch;
+            return s + e.name.size();
+        }
+    }
+    return nullptr;
+}
+
+// 텍스트 조각 하나를 엔티티를 풀며 붙임.
+// &#0; 은 pugixml 노드 값(C 문자열)을 거기서 끝내므로 조각의 나머지도 버린다
+void append_text(const char* p, const char* end, std::string& out) {
+    while (p < end) {
+        const char* amp = static_cast<const char*>(std::memchr(p, '&', size_t(end - p)));
+        if (!amp) { out.append(p, end); return; }
+        out.append(p, amp);
+        uint32_t cp = 0;
+        if (const char* next = decode_entity(amp, end, cp)) {
+            if (cp == 0) return;
+            append_utf8(out, cp);
+            p = next;
+        } else {
+            out.push_back('&');
+            p = amp + 1;
+        }
+    }
+}
+
+// pugixml encoding_auto 가 UTF-8 로 보는 입력인지 (BOM/NUL 바이트로 UTF-16/32, 선언으로 latin1 판별)
+bool utf8_input(const char* p, const char* end) {
+    const size_t n = size_t(end - p);
+    if (n >= 2) {
+        const unsigned char b0 = (unsigned char)p[0], b1 = (unsigned char)p[1];
+        if ((b0 == 0xFE && b1 == 0xFF) || (b0 == 0xFF && b1 == 0xFE)) return false;
+        if (b0 == 0 || b1 == 0) return false;
+    }
+    if (!starts_with(p, end, "<?xm")) return true;
+    const char* decl_end = find_lit(p, end, "?>");
+    const char* enc = decl_end ? find_lit(p, decl_end, "encoding") : nullptr;
+    if (!enc) return true;
+    const char* q = skip_ws(enc + 8, decl_end);
+    if (q >= decl_end || *q != '=') return true;
+    q = skip_ws(q + 1, decl_end);
+    if (q >= decl_end || (*q != '"' && *q != '\'')) return true;
+    const char quote = *q++;
+    const char* qe = static_cast<const char*>(std::memchr(q, quote, size_t(decl_end - q)));
+    if (!qe) return true;
+    std::string name(q, qe);
+    for (char& c : name) c = char(c | 0x20);
+    return name != "iso-8859-1" && name != "latin1";
+}
+
+} // namespace
+
+XhtmlScanner::Result XhtmlScanner::scan(const char* data, size_t n, std::string& out) {
+    const char* p = data;
+    const char* const end = data + n;
+    if (!utf8_input(p, end)) return Result::kNotUtf8;
+    if (starts_with(p, end, "\xEF\xBB\xBF")) p += 3;
+
+    const size_t start = out.size();
+    auto malformed = [&] {
+        out.resize(start);
+        return Result::kMalformed;
+    };
+
+    // 어디까지 텍스트를 모을지 (depth = 열린 엘리먼트 수 = 지금 위치의 부모 깊이)
+    // - html 없음: 문서 전체 (pugixml 은 최상위 텍스트 노드를 만들지 않으므로 텍스트는 depth > 0 만)
+    // - 최상위 <html> 이 나오면 그때까지 모은 걸 버리고, 그 html 의 첫 <body>(depth 2) 안쪽만
+    bool html_mode = false, in_html = false, in_body = false, body_seen = false, any_element = false;
+    size_t hidden = 0;   // 건너뛰는 script/style 엘리먼트의 깊이 (0 = 없음)
+    auto in_region = [&](size_t depth) { return !html_mode || (in_body && depth >= 2); };
+
+    auto open_element = [&](std::string_view name) {
+        const size_t depth = open_.size();
+        if (depth == 0) {
+            any_element = true;
+            if (!html_mode && name == "html") {
+                html_mode = in_html = true;
+                out.resize(start);
+            }
+        } else if (depth == 1 && in_html && !body_seen && name == "body") {
+            in_body = body_seen = true;
+        }
+        if (!hidden && in_region(depth) && classify_tag(name) == TagClass::kHidden) hidden = depth + 1;
+        open_.push_back(name);
+    };
+    auto close_element = [&] {
+        const size_t depth = open_.size();
+        const std::string_view name = open_.back();
+        if (hidden == depth) hidden = 0;
+        else if (!hidden && in_region(depth - 1) && classify_tag(name) == TagClass::kBlock) out.push_back(' ');
+        if (depth == 2 && in_body) in_body = false;
+        if (depth == 1) in_html = false;
+        open_.pop_back();
+    };
+
+    open_.clear();
+    while (p < end) {
+        // ---- 텍스트 ----
+        if (*p != '<') {
+            const char* lt = static_cast<const char*>(std::memchr(p, '<', size_t(end - p)));
+            if (!lt) lt = end;
+            const size_t depth = open_.size();
+            if (!hidden && depth > 0 && in_region(depth) && skip_ws(p, lt) != lt)
+                append_text(p, lt, out);
+            p = lt;
+            continue;
+        }
+
+        const char* s = p + 1;
+        if (s >= end) return malformed();
+
+        // ---- <!-- -->, <![CDATA[ ]]>, <!DOCTYPE > ----
+        if (*s == '!') {
+            if (starts_with(s, end, "!--")) {
+                const char* c = find_lit(s + 3, end, "-->");
+                if (!c) return malformed();
+                p = c + 3;
+            } else if (starts_with(s, end, "![CDATA[")) {
+                const char* b = s + 8;
+                const char* c = find_lit(b, end, "]]>");
+                if (!c) return malformed();
+                if (!hidden && in_region(open_.size())) out.append(b, c);
+                p = c + 3;
+            } else if (starts_with(s, end, "!DOCTYPE")) {
+                // 내부 부분집합 [...] 과 따옴표 안의 '>' 는 건너뜀
+                int depth = 0;
+                const char* q = s + 8;
+                for (; q < end; ++q) {
+                    if (*q == '"' || *q == '\'') {
+                        q = static_cast<const char*>(std::memchr(q + 1, *q, size_t(end - q - 1)));
+                        if (!q) return malformed();
+                    } else if (*q == '[') ++depth;
+                    else if (*q == ']') --depth;
+                    else if (*q == '>' && depth <= 0) break;
+                }
+                if (q >= end) return malformed();
+                p = q + 1;
+            } else {
+                return malformed();
+            }
+            continue;
+        }
+
+        // ---- <? ?> (XML 선언 포함) ----
+        if (*s == '?') {
+            const char* c = find_lit(s + 1, end, "?>");
+            if (!c) return malformed();
+            p = c + 2;
+            continue;
+        }
+
+        // ---- </name> ----
+        if (*s == '/') {
+            const char* nb = s + 1;
+            const char* ne = skip_name(nb, end);
+            const char* q = skip_ws(ne, end);
+            if (q >= end || *q != '>') return malformed();
+            if (open_.empty() || open_.back() != std::string_view(nb, size_t(ne - nb))) return malformed();
+            close_element();
+            p = q + 1;
+            continue;
+        }
+
+        // ---- <name attr="..." ...> / <name ... /> ----
+        if (!is_name_start((unsigned char)*s)) return malformed();
+        const char* ne = skip_name(s, end);
+        open_element(std::string_view(s, size_t(ne - s)));
+
+        const char* q = ne;
+        bool self_closing = false;
+        for (;;) {
+            if (q >= end) return malformed();
+            if (*q == '>') break;
+            if (*q == '/') {
+                if (q + 1 >= end || q[1] != '>') return malformed();
+                self_closing = true;
+                ++q;
+                break;
+            }
+            // 이름 바로 뒤나 속성 사이에는 공백이 있어야 한다
+            if (!is_ws(*q)) return malformed();
+            q = skip_ws(q, end);
+            if (q >= end) return malformed();
+            if (!is_name_start((unsigned char)*q)) continue;   // '>' 또는 '/' 는 위에서 처리
+
+            q = skip_ws(skip_name(q, end), end);
+            if (q >= end || *q != '=') return malformed();
+            q = skip_ws(q + 1, end);
+            if (q >= end || (*q != '"' && *q != '\'')) return malformed();
+            q = static_cast<const char*>(std::memchr(q + 1, *q, size_t(end - q - 1)));
+            if (!q) return malformed();
+            ++q;
+            if (q < end && *q != '>' && *q != '/' && !is_ws(*q)) return malformed();
+        }
+        if (self_closing) close_element();
+        p = q + 1;
+    }
+
+    // 닫히지 않은 엘리먼트, 엘리먼트가 하나도 없는 문서는 pugixml 도 실패
+    if (!open_.empty() || !any_element) return malformed();
+    return Result::kOk;
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// ---- DOM 없이 XHTML 을 한 번 훑어 본문 텍스트만 뽑는 스캐너 ----
+// pugixml 경로(load_buffer_inplace(parse_cdata | parse_escapes) → html/body 아래 collect_text)와
+// 같은 바이트를 내도록 맞춘 단일 패스 토크나이저. 트리/노드를 만들지 않고 열린 엘리먼트 이름만 스택에 둔다.
+// - 텍스트 조각: 공백(space/tab/CR/LF)만 있는 조각은 버림, 엔티티(&amp; &lt; &gt; &apos; &quot; &#N; &#xN;)는
+//   바로 풀어서 붙임, 모르는 엔티티(&nbsp; 등)는 원문 그대로
+// - CDATA 는 그대로, 주석/PI/DOCTYPE 은 건너뜀
+// - 태그 분류는 classify_tag (script/style 하위 전체 생략, 블록성 태그가 닫히면 ' ' 하나)
+// - <html> 이 있으면 첫 <body> 안쪽만, 없으면 문서 전체
+// 형식 오류(닫는 태그 불일치, 끝나지 않은 태그/주석 등)는 pugixml 처럼 문서 전체를 버린다
+class XhtmlScanner {
+public:
+    enum class Result {
+        kOk,
+        kMalformed,   // pugixml 도 실패하는 문서 → 텍스트 없음
+        kNotUtf8,     // UTF-16/32, latin1 선언 → 인코딩 변환이 필요하니 pugixml 경로로
+    };
+
+    // data[0, n) 의 본문 텍스트를 out 뒤에 붙임 (kOk 가 아니면 out 길이는 그대로)
+    Result scan(const char* data, size_t n, std::string& out);
+
+private:
+    std::vector<std::string_view> open_;   // 열린 엘리먼트 이름 (입력 버퍼 안을 가리킴), 호출마다 재사용
+};
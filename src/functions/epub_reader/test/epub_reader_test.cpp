@@ -0,0 +1,124 @@
+#include "epub_reader.hpp"
+
+#include <gtest/gtest.h>
+#include <zip.h>
+
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+// ---- 챕터 텍스트: 스트리밍 스캐너 vs pugixml DOM ----
+// sample.epub 의 모든 spine 문서에 대해 두 방식의 텍스트가 바이트 단위로 같아야 한다
+
+namespace {
+
+const char* const kSample = EPUB2VOCAB_SAMPLE_EPUB;
+
+// spine 인덱스 → 그 문서의 텍스트 (스트리밍 모드는 공백 압축을 하지 않으므로 파서 출력 그대로)
+std::map<size_t, std::string> spine_texts(XhtmlParser parser, unsigned jobs = 1, const std::string& epub = kSample) {
+    set_xhtml_parser(parser);
+    std::map<size_t, std::string> out;
+    extract_epub_text_stream(epub, [&](const char* data, size_t n, size_t spine) {
+        out[spine].append(data, n);
+    }, jobs);
+    set_xhtml_parser(XhtmlParser::kDom);
+    return out;
+}
+
+// UTF-16LE (BOM 포함) 로 인코딩 (ASCII 원문만)
+std::string utf16le(const std::string& ascii) {
+    std::string out = "\xFF\xFE";
+    for (char c : ascii) {
+        out.push_back(c);
+        out.push_back('\0');
+    }
+    return out;
+}
+
+// 챕터 세 개(UTF-8, UTF-16LE, ISO-8859-1)짜리 EPUB 을 libzip 으로 만든다 (기본 deflate → 챕터는 scratch.xml 에 풀림)
+std::filesystem::path write_non_utf8_epub() {
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "epub2vocab_non_utf8.epub";
+    std::filesystem::remove(path);
+    static const std::vector<std::pair<std::string, std::string>> files = {
+        { "mimetype", "application/epub+zip" },
+        { "META-INF/container.xml",
+          "<?xml version=\"1.0\"?><container version=\"1.0\" xmlns=\"urn:oasis:names:tc:opendocument:xmlns:container\">"
+          "<rootfiles><rootfile full-path=\"content.opf\" media-type=\"application/oebps-package+xml\"/>"
+          "</rootfiles></container>" },
+        { "content.opf",
+          "<?xml version=\"1.0\"?><package version=\"2.0\" xmlns=\"http://www.idpf.org/2007/opf\"><manifest>"
+          "<item id=\"a\" href=\"a.xhtml\" media-type=\"application/xhtml+xml\"/>"
+          "<item id=\"b\" href=\"b.xhtml\" media-type=\"application/xhtml+xml\"/>"
+          "<item id=\"c\" href=\"c.xhtml\" media-type=\"application/xhtml+xml\"/>"
+          "</manifest><spine><itemref idref=\"a\"/><itemref idref=\"b\"/><itemref idref=\"c\"/></spine></package>" },
+        { "a.xhtml", "<html><body><p>plain utf8 chapter</p></body></html>" },
+        { "b.xhtml", utf16le("<?xml version=\"1.0\" encoding=\"UTF-16\"?>"
+                             "<html><body><p>wide <b>utf16</b> chapter &amp; more</p><p>second</p></body></html>") },
+        { "c.xhtml", "<?xml version=\"1.0\" encoding=\"ISO-8859-1\"?>"
+                     "<html><body><p>caf\xE9 latin1 chapter</p></body></html>" },
+    };
+    int err = 0;
+    zip_t* z = zip_open(path.string().c_str(), ZIP_CREATE | ZIP_TRUNCATE, &err);
+    EXPECT_NE(z, nullptr) << "libzip error " << err;
+    if (!z) return path;
+    for (const auto& [name, data] : files) {
+        zip_source_t* src = zip_source_buffer(z, data.data(), data.size(), 0);   // files 는 zip_close 까지 살아 있음
+        EXPECT_GE(zip_file_add(z, name.c_str(), src, ZIP_FL_OVERWRITE), 0) << name;
+    }
+    EXPECT_EQ(zip_close(z), 0);
+    return path;
+}
+
+} // namespace
+
+TEST(XhtmlParser, DefaultIsDom) {
+    // 기본값으로 돌린 결과가 kDom 을 명시한 결과와 같은지 (set_xhtml_parser 를 부르기 전 첫 테스트)
+    std::map<size_t, std::string> def;
+    extract_epub_text_stream(kSample, [&](const char* data, size_t n, size_t spine) {
+        def[spine].append(data, n);
+    });
+    EXPECT_EQ(def, spine_texts(XhtmlParser::kDom));
+}
+
+TEST(XhtmlParser, StreamMatchesDomOnEverySpineDocument) {
+    const auto dom = spine_texts(XhtmlParser::kDom);
+    const auto stream = spine_texts(XhtmlParser::kStream);
+    ASSERT_FALSE(dom.empty());
+    EXPECT_EQ(dom.size(), stream.size());
+    for (const auto& [spine, text] : dom) {
+        auto it = stream.find(spine);
+        ASSERT_NE(it, stream.end()) << "spine " << spine << " missing from stream output";
+        EXPECT_EQ(text, it->second) << "spine " << spine;
+    }
+}
+
+TEST(XhtmlParser, VerifyReportsIdentical) {
+    EXPECT_TRUE(verify_xhtml_parser(kSample));
+}
+
+TEST(XhtmlParser, FullTextMatchesAcrossParsersAndJobs) {
+    // 책 전체 텍스트(공백 압축 + 챕터 위치)도 같아야 하고, 병렬 추출도 순서가 같아야 한다
+    std::vector<std::pair<size_t, uint32_t>> dom_marks, stream_marks;
+    set_xhtml_parser(XhtmlParser::kDom);
+    const std::string dom = extract_epub_text(kSample, 1, &dom_marks);
+    set_xhtml_parser(XhtmlParser::kStream);
+    const std::string stream = extract_epub_text(kSample, 4, &stream_marks);
+    set_xhtml_parser(XhtmlParser::kDom);
+    EXPECT_FALSE(dom.empty());
+    EXPECT_EQ(dom, stream);
+    EXPECT_EQ(dom_marks, stream_marks);
+}
+
+TEST(XhtmlParser, VerifyHandlesNonUtf8DeflatedChapters) {
+    // 스캐너가 kNotUtf8 을 내는 문서: verify 가 같은 압축 해제 버퍼를 두 번 파싱하지 않는지 (예전엔 거짓 불일치)
+    const auto path = write_non_utf8_epub();
+    EXPECT_TRUE(verify_xhtml_parser(path.string()));
+
+    const auto dom = spine_texts(XhtmlParser::kDom, 1, path.string());
+    EXPECT_EQ(dom, spine_texts(XhtmlParser::kStream, 1, path.string()));
+    ASSERT_EQ(dom.size(), 3u);
+    EXPECT_NE(dom.at(1).find("wide utf16 chapter & more"), std::string::npos) << dom.at(1);
+    EXPECT_NE(dom.at(2).find("caf\xC3\xA9 latin1 chapter"), std::string::npos) << dom.at(2);
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,334 @@
+#include "epub_reader.hpp"
+#include "mmap_file.hpp"
+#include "stored_entries.hpp"
+
+#include <gtest/gtest.h>
+#include <zip.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+// ---- index_stored_entries: 매핑 안의 zero-copy 뷰 vs libzip zip_fread ----
+// - sample.epub (mimetype 만 stored) 과, 그 엔트리를 전부 stored 로 다시 묶은 사본에서 뷰가 zip_fread 와 같은지
+// - 중앙 디렉터리가 깨졌거나 ZIP64 인 엔트리는 목록에서 빠지고 libzip 경로로 같은 텍스트가 나오는지
+// 테스트용 zip 은 아래 build_zip 으로 직접 만든다 (stored 만, 필요하면 ZIP64 크기/EOCD)
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const char* const kSample = EPUB2VOCAB_SAMPLE_EPUB;
+
+uint32_t crc32_of(std::string_view s) {
+    uint32_t c = 0xFFFFFFFFu;
+    for (unsigned char b : s) {
+        c ^= b;
+        for (int k = 0; k < 8; ++k) c = (c >> 1) ^ (0xEDB88320u & (0u - (c & 1)));
+    }
+    return ~c;
+}
+
+void put16(std::string& o, uint32_t v) { o.push_back(char(v)); o.push_back(char(v >> 8)); }
+void put32(std::string& o, uint32_t v) { put16(o, v & 0xFFFF); put16(o, v >> 16); }
+void put64(std::string& o, uint64_t v) { put32(o, uint32_t(v)); put32(o, uint32_t(v >> 32)); }
+void set16(std::string& o, size_t at, uint32_t v) { o[at] = char(v); o[at + 1] = char(v >> 8); }
+void set32(std::string& o, size_t at, uint32_t v) { set16(o, at, v & 0xFFFF); set16(o, at + 2, v >> 16); }
+
+struct ZipEntry {
+    std::string name, data;
+    bool zip64 = false;   // 로컬/중앙 헤더 크기를 0xFFFFFFFF 로 두고 ZIP64 extra 에 실제 크기
+};
+
+struct BuiltZip {
+    std::string bytes;
+    std::vector<size_t> local, central;   // 엔트리별 로컬 헤더 / 중앙 디렉터리 헤더 오프셋
+    size_t eocd = 0;
+};
+
+BuiltZip build_zip(const std::vector<ZipEntry>& entries, bool zip64_eocd = false) {
+    BuiltZip z;
+    auto zip64_extra = [](const ZipEntry& e) {
+        std::string x;
+        put16(x, 0x0001);
+        put16(x, 16);
+        put64(x, e.data.size());   // 원래 크기, 압축 크기 순
+        put64(x, e.data.size());
+        return x;
+    };
+    for (const auto& e : entries) {
+        const std::string extra = e.zip64 ? zip64_extra(e) : std::string();
+        const uint32_t sz = e.zip64 ? 0xFFFFFFFFu : uint32_t(e.data.size());
+        z.local.push_back(z.bytes.size());
+        std::string& o = z.bytes;
+        put32(o, 0x04034b50);
+        put16(o, e.zip64 ? 45 : 20);
+        put16(o, 0);                 // flags
+        put16(o, 0);                 // method: stored
+        put16(o, 0);                 // time
+        put16(o, 0x21);              // date 1980-01-01
+        put32(o, crc32_of(e.data));
+        put32(o, sz);
+        put32(o, sz);
+        put16(o, uint32_t(e.name.size()));
+        put16(o, uint32_t(extra.size()));
+        o += e.name;
+        o += extra;
+        o += e.data;
+    }
+    const size_t cd_start = z.bytes.size();
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const ZipEntry& e = entries[i];
+        const std::string extra = e.zip64 ? zip64_extra(e) : std::string();
+        const uint32_t sz = e.zip64 ? 0xFFFFFFFFu : uint32_t(e.data.size());
+        z.central.push_back(z.bytes.size());
+        std::string& o = z.bytes;
+        put32(o, 0x02014b50);
+        put16(o, 45);                // version made by
+        put16(o, e.zip64 ? 45 : 20);
+        put16(o, 0);
+        put16(o, 0);
+        put16(o, 0);
+        put16(o, 0x21);
+        put32(o, crc32_of(e.data));
+        put32(o, sz);
+        put32(o, sz);
+        put16(o, uint32_t(e.name.size()));
+        put16(o, uint32_t(extra.size()));
+        put16(o, 0);                 // comment
+        put16(o, 0);                 // disk
+        put16(o, 0);                 // internal attr
+        put32(o, 0);                 // external attr
+        put32(o, uint32_t(z.local[i]));
+        o += e.name;
+        o += extra;
+    }
+    const size_t cd_size = z.bytes.size() - cd_start;
+    std::string& o = z.bytes;
+    if (zip64_eocd) {
+        const size_t rec = o.size();
+        put32(o, 0x06064b50);
+        put64(o, 44);
+        put16(o, 45);
+        put16(o, 45);
+        put32(o, 0);
+        put32(o, 0);
+        put64(o, entries.size());
+        put64(o, entries.size());
+        put64(o, cd_size);
+        put64(o, cd_start);
+        put32(o, 0x07064b50);        // locator
+        put32(o, 0);
+        put64(o, rec);
+        put32(o, 1);
+    }
+    z.eocd = o.size();
+    put32(o, 0x06054b50);
+    put16(o, 0);
+    put16(o, 0);
+    put16(o, zip64_eocd ? 0xFFFF : uint32_t(entries.size()));
+    put16(o, zip64_eocd ? 0xFFFF : uint32_t(entries.size()));
+    put32(o, zip64_eocd ? 0xFFFFFFFFu : uint32_t(cd_size));
+    put32(o, zip64_eocd ? 0xFFFFFFFFu : uint32_t(cd_start));
+    put16(o, 0);
+    return z;
+}
+
+StoredEntries index_of(const std::string& bytes) { return index_stored_entries(bytes.data(), bytes.size()); }
+
+fs::path write_temp(const std::string& name, const std::string& bytes) {
+    const fs::path p = fs::temp_directory_path() / name;
+    std::ofstream(p, std::ios::binary).write(bytes.data(), std::streamsize(bytes.size()));
+    return p;
+}
+
+// libzip 으로 읽은 엔트리 전부 (이름 → 내용, stored 인 이름 목록)
+struct ZipContents {
+    std::map<std::string, std::string> data;
+    std::vector<std::string> stored;
+};
+
+ZipContents read_with_libzip(const fs::path& path) {
+    ZipContents out;
+    int err = 0;
+    zip_t* z = zip_open(path.string().c_str(), ZIP_RDONLY, &err);
+    EXPECT_NE(z, nullptr) << path << ": libzip error " << err;
+    if (!z) return out;
+    const zip_int64_t n = zip_get_num_entries(z, 0);
+    for (zip_int64_t i = 0; i < n; ++i) {
+        zip_stat_t st;
+        zip_stat_init(&st);
+        if (zip_stat_index(z, zip_uint64_t(i), 0, &st) != 0) {
+            ADD_FAILURE() << "zip_stat_index " << i;
+            continue;
+        }
+        std::string buf(size_t(st.size), '\0');
+        zip_file_t* f = zip_fopen_index(z, zip_uint64_t(i), 0);
+        EXPECT_NE(f, nullptr) << st.name;
+        if (!f) continue;
+        EXPECT_EQ(zip_fread(f, buf.data(), st.size), zip_int64_t(st.size)) << st.name;
+        zip_fclose(f);
+        out.data[st.name] = std::move(buf);
+        if (st.comp_method == ZIP_CM_STORE && st.encryption_method == ZIP_EM_NONE) out.stored.push_back(st.name);
+    }
+    zip_close(z);
+    return out;
+}
+
+// 뷰 하나하나가 zip_fread 결과와 같은지
+void expect_views_match(const StoredEntries& stored, const ZipContents& zc) {
+    for (const auto& [name, view] : stored) {
+        auto it = zc.data.find(name);
+        ASSERT_NE(it, zc.data.end()) << name << " not in libzip listing";
+        EXPECT_EQ(view, it->second) << name;
+    }
+}
+
+// mimetype + container.xml + OPF + 챕터 두 개짜리 EPUB
+std::vector<ZipEntry> tiny_epub() {
+    return {
+        { "mimetype", "application/epub+zip" },
+        { "META-INF/container.xml",
+          "<?xml version=\"1.0\"?><container version=\"1.0\" xmlns=\"urn:oasis:names:tc:opendocument:xmlns:container\">"
+          "<rootfiles><rootfile full-path=\"OEBPS/content.opf\" media-type=\"application/oebps-package+xml\"/>"
+          "</rootfiles></container>" },
+        { "OEBPS/content.opf",
+          "<?xml version=\"1.0\"?><package version=\"2.0\" xmlns=\"http://www.idpf.org/2007/opf\"><manifest>"
+          "<item id=\"c1\" href=\"c1.xhtml\" media-type=\"application/xhtml+xml\"/>"
+          "<item id=\"c2\" href=\"text/c2.xhtml\" media-type=\"application/xhtml+xml\"/>"
+          "</manifest><spine><itemref idref=\"c1\"/><itemref idref=\"c2\"/></spine></package>" },
+        { "OEBPS/c1.xhtml", "<html><body><p>alpha stored chapter</p></body></html>" },
+        { "OEBPS/text/c2.xhtml", "<html><body><p>beta <b>second</b> chapter</p></body></html>" },
+    };
+}
+
+} // namespace
+
+TEST(StoredEntries, SampleViewsMatchZipFread) {
+    const MappedFile map{ fs::path(kSample) };
+    const StoredEntries stored = index_stored_entries(map.data(), map.size());
+    const ZipContents zc = read_with_libzip(kSample);
+    ASSERT_FALSE(zc.data.empty());
+    // libzip 이 stored 로 보는 엔트리는 (ZIP64 가 아니면) 전부 목록에 있어야 함
+    EXPECT_EQ(stored.size(), zc.stored.size());
+    for (const auto& name : zc.stored) EXPECT_TRUE(stored.count(name)) << name;
+    expect_views_match(stored, zc);
+}
+
+TEST(StoredEntries, StoredCopyOfSampleMatchesZipFreadAndText) {
+    // sample.epub 은 mimetype 만 stored 라서, 엔트리를 전부 stored 로 다시 묶어 모든 문서를 zero-copy 경로로 읽힌다
+    const ZipContents orig = read_with_libzip(kSample);
+    std::vector<ZipEntry> entries;
+    entries.push_back({ "mimetype", orig.data.at("mimetype") });
+    for (const auto& [name, data] : orig.data)
+        if (name != "mimetype") entries.push_back({ name, data });
+    const BuiltZip copy = build_zip(entries);
+    const fs::path path = write_temp("epub2vocab_stored_copy.epub", copy.bytes);
+
+    const MappedFile map{ path };
+    const StoredEntries stored = index_stored_entries(map.data(), map.size());
+    const ZipContents zc = read_with_libzip(path);
+    EXPECT_EQ(zc.data, orig.data);
+    EXPECT_EQ(stored.size(), orig.data.size());
+    expect_views_match(stored, zc);
+
+    // inflate 경로(원본)와 zero-copy 경로(사본)의 본문이 같아야 함
+    EXPECT_EQ(extract_epub_text(path.string()), extract_epub_text(kSample));
+    fs::remove(path);
+}
+
+TEST(StoredEntries, MalformedCentralDirectoryIsSkipped) {
+    const std::vector<ZipEntry> entries = { { "a.txt", "first" }, { "b.txt", "second" }, { "c.txt", "third" } };
+    const BuiltZip good = build_zip(entries);
+    ASSERT_EQ(index_of(good.bytes).size(), 3u);
+    EXPECT_EQ(index_of(good.bytes).at("b.txt"), "second");
+
+    EXPECT_TRUE(index_of(good.bytes.substr(0, 21)).empty());                    // EOCD 자리도 없음
+    EXPECT_TRUE(index_of(good.bytes.substr(0, good.eocd)).empty());             // EOCD 없음
+
+    std::string z = good.bytes;
+    set32(z, good.eocd + 16, uint32_t(z.size()));                               // 중앙 디렉터리가 파일 밖
+    EXPECT_TRUE(index_of(z).empty());
+
+    z = good.bytes;
+    set32(z, good.central[1], 0xDEADBEEF);                                      // 둘째 헤더 서명 깨짐 → 거기서 멈춤
+    auto s = index_of(z);
+    EXPECT_EQ(s.size(), 1u);
+    EXPECT_TRUE(s.count("a.txt"));
+
+    z = good.bytes;
+    set16(z, good.eocd + 10, 7);                                                // 개수가 실제보다 많음
+    EXPECT_EQ(index_of(z).size(), 3u);
+
+    z = good.bytes;
+    set32(z, good.central[1] + 42, uint32_t(good.central[0]));                  // 로컬 헤더 오프셋이 엉뚱한 곳
+    s = index_of(z);
+    EXPECT_EQ(s.size(), 2u);
+    EXPECT_FALSE(s.count("b.txt"));
+
+    z = good.bytes;
+    set32(z, good.central[2] + 20, 1u << 30);                                   // 크기가 파일을 넘어감
+    set32(z, good.central[2] + 24, 1u << 30);
+    s = index_of(z);
+    EXPECT_EQ(s.size(), 2u);
+    EXPECT_FALSE(s.count("c.txt"));
+
+    z = good.bytes;
+    set16(z, good.central[0] + 10, 8);                                          // deflate
+    set16(z, good.central[1] + 8, 1);                                           // 암호화
+    s = index_of(z);
+    EXPECT_EQ(s.size(), 1u);
+    EXPECT_TRUE(s.count("c.txt"));
+}
+
+TEST(StoredEntries, Zip64IsLeftToLibzip) {
+    std::vector<ZipEntry> entries = { { "small.txt", "plain" }, { "big.txt", "zip64 sizes", true } };
+    const BuiltZip z64_entry = build_zip(entries);
+    const auto s = index_of(z64_entry.bytes);
+    EXPECT_EQ(s.size(), 1u);
+    EXPECT_TRUE(s.count("small.txt"));
+    EXPECT_TRUE(index_of(build_zip(entries, true).bytes).empty());              // ZIP64 EOCD → 목록 없음
+
+    // libzip 은 둘 다 읽는다 (목록에서 빠진 엔트리의 대체 경로)
+    for (bool eocd64 : { false, true }) {
+        const fs::path path = write_temp("epub2vocab_zip64.zip", build_zip(entries, eocd64).bytes);
+        const ZipContents zc = read_with_libzip(path);
+        EXPECT_EQ(zc.data.size(), 2u) << eocd64;
+        if (zc.data.count("big.txt")) {
+            EXPECT_EQ(zc.data.at("big.txt"), "zip64 sizes") << eocd64;
+        }
+        fs::remove(path);
+    }
+}
+
+TEST(StoredEntries, ExtractFallsBackToLibzip) {
+    // 전부 zero-copy / 둘째 챕터만 ZIP64 (libzip) / ZIP64 EOCD (목록 없음, 전부 libzip) → 같은 본문
+    std::vector<ZipEntry> plain = tiny_epub();
+    std::vector<ZipEntry> mixed = plain;
+    mixed[4].zip64 = true;
+
+    const std::pair<BuiltZip, size_t> cases[] = {
+        { build_zip(plain), plain.size() },
+        { build_zip(mixed), plain.size() - 1 },
+        { build_zip(plain, true), 0 },
+    };
+    std::string expected;
+    for (size_t i = 0; i < std::size(cases); ++i) {
+        const auto& [zip, indexed] = cases[i];
+        EXPECT_EQ(index_of(zip.bytes).size(), indexed) << i;
+        const fs::path path = write_temp("epub2vocab_fallback.epub", zip.bytes);
+        const std::string text = extract_epub_text(path.string());
+        fs::remove(path);
+        if (i == 0) {
+            expected = text;
+            EXPECT_NE(text.find("alpha stored chapter"), std::string::npos) << text;
+            EXPECT_NE(text.find("beta second chapter"), std::string::npos) << text;
+        } else {
+            EXPECT_EQ(text, expected) << i;
+        }
+    }
+}
@@ -0,0 +1,117 @@
+#include "tag_class.hpp"
+#include "text_collector.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+// ---- collect_text (xml_tree_walker) vs 예전 재귀 구현 ----
+// 재귀 구현은 6ce925f 이전 collect_text_recursive 그대로이고, 태그 이름 판정만 classify_tag 로 바꿨다
+// (예전 is_hidden_tag/blockish 는 소문자 정확히 일치만 봐서 <SCRIPT>, <xhtml:p> 를 놓쳤다 → 아래 Names* 에서 따로 확인)
+
+namespace {
+
+void collect_text_recursive(const pugi::xml_node& node, std::string& out) {
+    if (node.type() == pugi::node_pcdata || node.type() == pugi::node_cdata) {
+        out.append(node.value());
+        return;
+    }
+    if (node.type() == pugi::node_element) {
+        const TagClass tc = classify_tag(node.name());
+        if (tc == TagClass::kHidden) return;
+        for (pugi::xml_node ch = node.first_child(); ch; ch = ch.next_sibling())
+            collect_text_recursive(ch, out);
+        if (tc == TagClass::kBlock) out.push_back(' ');
+        return;
+    }
+    for (pugi::xml_node ch = node.first_child(); ch; ch = ch.next_sibling())
+        collect_text_recursive(ch, out);
+}
+
+// 챕터 파싱과 같은 플래그로 읽고 html/body (없으면 문서) 아래 텍스트
+struct Texts {
+    std::string walker, recursive;
+};
+
+Texts both(const std::string& xml) {
+    pugi::xml_document doc;
+    EXPECT_TRUE(doc.load_string(xml.c_str(), pugi::parse_cdata | pugi::parse_escapes)) << xml.substr(0, 80);
+    pugi::xml_node html = doc.child("html");
+    pugi::xml_node root = html ? html.child("body") : pugi::xml_node(doc);
+    Texts t;
+    collect_text(root, t.walker);
+    // 재귀 구현은 root 자신(body)도 엘리먼트로 분류하지만 body 는 kInline 이라 결과가 같다
+    for (pugi::xml_node ch = root.first_child(); ch; ch = ch.next_sibling())
+        collect_text_recursive(ch, t.recursive);
+    return t;
+}
+
+std::string collected(const std::string& xml) {
+    const Texts t = both(xml);
+    EXPECT_EQ(t.walker, t.recursive) << xml.substr(0, 80);
+    return t.walker;
+}
+
+std::string repeat(const std::string& s, int n) {
+    std::string out;
+    for (int i = 0; i < n; ++i) out += s;
+    return out;
+}
+
+} // namespace
+
+TEST(TextCollector, MatchesRecursiveOnBlocksAndInlines) {
+    EXPECT_EQ(collected("<html><head><title>T</title></head><body><p>a<b>b</b>c</p><p>d</p></body></html>"), "abc d ");
+    EXPECT_EQ(collected("<html><body><div><p>a</p></div>b<br/>c</body></html>"), "a  b c");
+    EXPECT_EQ(collected("<html><body><ul><li>one</li><li><em>two</em></li></ul>tail</body></html>"), "one two  tail");
+    EXPECT_EQ(collected("<html><body><section><h1>x</h1><article><p/></article></section></body></html>"), "x    ");
+    EXPECT_EQ(collected("<root>no <span>html</span> element<p>p</p></root>"), "no html elementp ");
+    EXPECT_EQ(collected("<html><body/></html>"), "");
+}
+
+TEST(TextCollector, MatchesRecursiveOnHiddenElements) {
+    EXPECT_EQ(collected("<html><body><p>x<script>var a = 1;<p>no</p></script>y</p>z</body></html>"), "xy z");
+    EXPECT_EQ(collected("<html><body><div><style>s{}</style></div>t</body></html>"), " t");
+    EXPECT_EQ(collected("<html><body><p>a</p><script><div><p>deep</p></div></script></body></html>"), "a ");
+    EXPECT_EQ(collected("<html><body><style/><p>after</p></body></html>"), "after ");
+}
+
+TEST(TextCollector, MatchesRecursiveOnCdataAndEntities) {
+    EXPECT_EQ(collected("<html><body><p><![CDATA[<raw>]]>&amp;&#x41;</p></body></html>"), "<raw>&A ");
+}
+
+TEST(TextCollector, NamesFoldCaseAndDropPrefix) {
+    // 예전 구현은 <SCRIPT> 안 텍스트를 그대로 내보내고 <xhtml:p>/<P> 뒤에 공백을 안 넣었다
+    EXPECT_EQ(collected("<html><body>a<SCRIPT>hidden</SCRIPT>b<Style>h</Style>c</body></html>"), "abc");
+    EXPECT_EQ(collected("<html xmlns:xhtml=\"http://www.w3.org/1999/xhtml\"><body>"
+                        "<xhtml:p>one</xhtml:p><xhtml:p>two</xhtml:p><P>three</P><xhtml:SCRIPT>x</xhtml:SCRIPT>"
+                        "</body></html>"),
+              "one two three ");
+}
+
+TEST(TextCollector, DeepNestingMatchesRecursive) {
+    // 블록/인라인이 번갈아 5000 단계 (재귀 구현도 버틸 깊이), 중간마다 텍스트와 숨김 엘리먼트
+    const int depth = 5000;
+    std::string open, close;
+    for (int i = 0; i < depth; ++i) {
+        const char* tag = i % 3 == 0 ? "div" : i % 3 == 1 ? "span" : "xhtml:p";
+        open += std::string("<") + tag + ">w" + std::to_string(i);
+        if (i % 97 == 0) open += "<SCRIPT>s</SCRIPT>";
+        close = std::string("</") + tag + ">" + (i % 50 == 0 ? "t" : "") + close;
+    }
+    const std::string xml = "<html><body>" + open + close + "</body></html>";
+    const std::string text = collected(xml);
+    EXPECT_EQ(text.find('s'), std::string::npos);
+    EXPECT_NE(text.find("w4999"), std::string::npos);
+}
+
+TEST(TextCollector, VeryDeepNestingDoesNotRecurse) {
+    // 재귀 구현이면 스택이 넘칠 깊이. 블록 닫힘 공백 개수만 확인
+    const int depth = 200000;
+    const std::string xml = "<html><body>" + repeat("<div>", depth) + "x" + repeat("</div>", depth) + "y</body></html>";
+    pugi::xml_document doc;
+    ASSERT_TRUE(doc.load_string(xml.c_str(), pugi::parse_cdata | pugi::parse_escapes));
+    std::string out;
+    collect_text(doc.child("html").child("body"), out);
+    EXPECT_EQ(out, "x" + std::string(depth, ' ') + "y");
+}
@@ -0,0 +1,446 @@
+#include "lemmatizer.hpp"
+#include "image_loader.hpp"
+#include "../../zipf_filter/src/zipf_filter.hpp"
+#include "py_runner/py_runner.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+  #include <windows.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const char     kMagic[8] = { 'E','2','V','L','E','M','A','\0' };
+const uint32_t kVersion  = 1;
+
+struct Header {
+    char     magic[8];
+    uint32_t version;
+    uint32_t words_size;    // 박혀 있는 WordList 이미지 바이트 수
+    uint32_t exc_count;
+    uint32_t reserved;
+};
+static_assert(sizeof(Header) == 24, "unexpected Header padding");
+
+size_t align4(size_t n) { return (n + 3) & ~size_t(3); }
+
+// NLTK WordNetCorpusReader.MORPHOLOGICAL_SUBSTITUTIONS (순서가 결과 순서를 정한다)
+struct Rule { const char* old_suffix; const char* new_suffix; };
+const Rule kNounRules[] = {
+    {"s", ""}, {"ses", "s"}, {"ves", "f"}, {"xes", "x"}, {"zes", "z"},
+    {"ches", "ch"}, {"shes", "sh"}, {"men", "man"}, {"ies", "y"},
+};
+const Rule kVerbRules[] = {
+    {"s", ""}, {"ies", "y"}, {"es", "e"}, {"es", ""},
+    {"ed", "e"}, {"ed", ""}, {"ing", "e"}, {"ing", ""},
+};
+const Rule kAdjRules[] = {
+    {"er", ""}, {"est", ""}, {"er", "e"}, {"est", "e"},
+};
+
+struct RuleSet { const Rule* begin; const Rule* end; };
+RuleSet rules_for(Lemmatizer::Pos pos) {
+    switch (pos) {
+        case Lemmatizer::kNoun: return { std::begin(kNounRules), std::end(kNounRules) };
+        case Lemmatizer::kVerb: return { std::begin(kVerbRules), std::end(kVerbRules) };
+        case Lemmatizer::kAdj:  return { std::begin(kAdjRules),  std::end(kAdjRules) };
+        default:                return { nullptr, nullptr };   // ADV: 규칙 없음 (예외 목록만)
+    }
+}
+
+// wn.morphy(pos=None) 의 POS_LIST 순서
+const Lemmatizer::Pos kMorphyOrder[] = {
+    Lemmatizer::kNoun, Lemmatizer::kVerb, Lemmatizer::kAdj, Lemmatizer::kAdv,
+};
+
+uint8_t pos_bit(char c) {
+    switch (c) {
+        case 'n': return Lemmatizer::kNoun;
+        case 'v': return Lemmatizer::kVerb;
+        case 'a': case 's': return Lemmatizer::kAdj;   // 위성 형용사는 ADJ 로
+        case 'r': return Lemmatizer::kAdv;
+        default:  return 0;
+    }
+}
+
+bool ends_with(std::string_view s, std::string_view suffix) {
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// apply_rules: 각 형태에 규칙을 한 번씩 적용한 결과 (NLTK 와 같은 순서, 중복 허용)
+std::vector<std::string> apply_rules(const std::vector<std::string>& forms, RuleSet rs) {
+    std::vector<std::string> out;
+    for (const auto& f : forms) {
+        for (const Rule* r = rs.begin; r != rs.end; ++r) {
+            if (!ends_with(f, r->old_suffix)) continue;
+            out.push_back(f.substr(0, f.size() - std::strlen(r->old_suffix)) + r->new_suffix);
+        }
+    }
+    return out;
+}
+
+std::vector<std::string> split_tabs(const std::string& line) {
+    std::vector<std::string> cols;
+    size_t a = 0;
+    while (true) {
+        size_t b = line.find('\t', a);
+        cols.push_back(line.substr(a, b == std::string::npos ? std::string::npos : b - a));
+        if (b == std::string::npos) break;
+        a = b + 1;
+    }
+    return cols;
+}
+
+fs::path exe_dir() {
+#ifdef _WIN32
+    wchar_t buf[MAX_PATH];
+    DWORD n = GetModuleFileNameW(nullptr, buf, MAX_PATH);
+    return n ? fs::path(buf).parent_path() : fs::current_path();
+#else
+    return fs::current_path();
+#endif
+}
+
+const char kTableTxt[] = "wordnet_lemma.txt";
+const char kTableBin[] = "wordnet_lemma.bin";
+
+Lemmatizer load_table_auto() {
+    std::string source;
+    Lemmatizer lem = load_or_rebuild_image(kTableTxt, kTableBin, Lemmatizer::from_table, Lemmatizer::open_image, &source);
+    if (!source.empty())
+        std::cout << "[info] loaded " << lem.size() << " lemma entries from " << source << "\n";
+    return lem;
+}
+
+// read_words: "Unique ..." 헤더/빈 줄 건너뛰고 [A-Za-z][A-Za-z'-]* 만 소문자로
+std::vector<std::string> read_vocab_words(const fs::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("cannot open: " + path.string());
+    auto is_alpha = [](unsigned char c){ return (c|32) >= 'a' && (c|32) <= 'z'; };
+
+    std::vector<std::string> words;
+    std::string line;
+    while (std::getline(in, line)) {
+        size_t a = 0, b = line.size();
+        while (a < b && std::isspace((unsigned char)line[a])) ++a;
+        while (b > a && std::isspace((unsigned char)line[b - 1])) --b;
+        if (a == b) continue;
+        std::string w = line.substr(a, b - a);
+
+        if (w.size() >= 6) {
+            std::string head = w.substr(0, 6);
+            for (auto& c : head) c = (char)std::tolower((unsigned char)c);
+            const bool boundary = w.size() == 6 || !(is_alpha((unsigned char)w[6])
+                || std::isdigit((unsigned char)w[6]) || w[6] == '_');
+            if (head == "unique" && boundary) continue;
+        }
+
+        bool ok = is_alpha((unsigned char)w[0]);
+        for (size_t i = 1; ok && i < w.size(); ++i) {
+            unsigned char c = (unsigned char)w[i];
+            ok = is_alpha(c) || c == '\'' || c == '-';
+        }
+        if (!ok) continue;
+        for (auto& c : w) c = (char)std::tolower((unsigned char)c);
+        words.push_back(std::move(w));
+    }
+    return words;
+}
+
+double ms_since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+} // namespace
+
+// ====== 이미지 생성/열기 ======
+
+Lemmatizer Lemmatizer::from_table(const fs::path& txt) {
+    std::ifstream in(txt, std::ios::binary);
+    if (!in) throw std::runtime_error("cannot open: " + txt.string());
+
+    struct Exc { uint8_t pos; std::string form; std::vector<std::string> bases; };
+    std::vector<std::pair<std::string, uint8_t>> index;
+    std::vector<Exc> excs;
+    std::vector<std::string> all;
+
+    std::string line;
+    size_t line_no = 0;
+    while (std::getline(in, line)) {
+        ++line_no;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+        auto cols = split_tabs(line);
+        if (cols[0] == "L" && cols.size() == 3) {
+            uint8_t mask = 0;
+            for (char c : cols[2]) mask |= pos_bit(c);
+            index.emplace_back(cols[1], mask);
+            all.push_back(cols[1]);
+        } else if (cols[0] == "E" && cols.size() >= 4 && cols[1].size() == 1 && pos_bit(cols[1][0])) {
+            Exc e{ pos_bit(cols[1][0]), cols[2], { cols.begin() + 3, cols.end() } };
+            all.push_back(e.form);
+            all.insert(all.end(), e.bases.begin(), e.bases.end());
+            excs.push_back(std::move(e));
+        } else {
+            throw std::runtime_error("lemma table: bad line " + std::to_string(line_no));
+        }
+    }
+
+    WordList words = WordList::from_words(std::move(all));
+    const uint32_t count = (uint32_t)words.size();
+
+    // 변화형 id 별로 예외를 모으되 파일 순서를 지킨다
+    std::vector<std::vector<uint32_t>> per_form(count);
+    uint32_t exc_count = 0;
+    for (const auto& e : excs) {
+        auto& dst = per_form[(uint32_t)words.find(e.form)];
+        for (const auto& b : e.bases) {
+            dst.push_back((uint32_t(e.pos) << 28) | (uint32_t)words.find(b));
+            ++exc_count;
+        }
+    }
+
+    const std::string_view wimg = words.image();
+    const size_t off_words  = sizeof(Header);
+    const size_t off_pos    = align4(off_words + wimg.size());
+    const size_t off_excoff = align4(off_pos + count);
+    const size_t off_exc    = off_excoff + sizeof(uint32_t) * (size_t(count) + 1);
+    const size_t total      = off_exc + sizeof(uint32_t) * size_t(exc_count);
+
+    std::vector<uint32_t> img((total + 3) / 4, 0);
+    char* base = reinterpret_cast<char*>(img.data());
+
+    Header h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = kVersion;
+    h.words_size = (uint32_t)wimg.size();
+    h.exc_count = exc_count;
+    std::memcpy(base, &h, sizeof(h));
+    std::memcpy(base + off_words, wimg.data(), wimg.size());
+
+    uint8_t* pos = reinterpret_cast<uint8_t*>(base + off_pos);
+    for (const auto& [w, mask] : index) pos[(uint32_t)words.find(w)] |= mask;
+
+    uint32_t* exc_off = reinterpret_cast<uint32_t*>(base + off_excoff);
+    uint32_t* exc     = reinterpret_cast<uint32_t*>(base + off_exc);
+    uint32_t at = 0;
+    for (uint32_t id = 0; id < count; ++id) {
+        exc_off[id] = at;
+        for (uint32_t v : per_form[id]) exc[at++] = v;
+    }
+    exc_off[count] = at;
+
+    Lemmatizer lem;
+    lem.owned_ = std::move(img);
+    lem.bind(reinterpret_cast<const char*>(lem.owned_.data()), total);
+    return lem;
+}
+
+Lemmatizer Lemmatizer::open_image(const fs::path& path) {
+    Lemmatizer lem;
+    lem.map_ = MappedFile(path);
+    lem.bind(lem.map_.data(), lem.map_.size());
+    return lem;
+}
+
+void Lemmatizer::bind(const char* base, size_t size) {
+    Header h;
+    if (!base || size < sizeof(Header))
+        throw std::runtime_error("lemma image: truncated header");
+    std::memcpy(&h, base, sizeof(h));
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0 || h.version != kVersion)
+        throw std::runtime_error("lemma image: bad magic/version");
+    if (sizeof(Header) + size_t(h.words_size) > size)
+        throw std::runtime_error("lemma image: size mismatch");
+
+    WordList words = WordList::view(base + sizeof(Header), h.words_size);
+    const size_t count      = words.size();
+    const size_t off_pos    = align4(sizeof(Header) + h.words_size);
+    const size_t off_excoff = align4(off_pos + count);
+    const size_t off_exc    = off_excoff + sizeof(uint32_t) * (count + 1);
+    if (off_exc + sizeof(uint32_t) * size_t(h.exc_count) != size)
+        throw std::runtime_error("lemma image: size mismatch");
+
+    image_      = base;
+    image_size_ = size;
+    words_      = std::move(words);
+    pos_        = reinterpret_cast<const uint8_t*>(base + off_pos);
+    exc_off_    = reinterpret_cast<const uint32_t*>(base + off_excoff);
+    exc_        = reinterpret_cast<const uint32_t*>(base + off_exc);
+}
+
+void Lemmatizer::save_image(const fs::path& path) const {
+    if (!image_) throw std::runtime_error("lemma image: nothing to save");
+    fs::path tmp = path;
+    tmp += ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) throw std::runtime_error("failed to create: " + tmp.string());
+        out.write(image_, (std::streamsize)image_size_);
+        if (!out) throw std::runtime_error("failed to write: " + tmp.string());
+    }
+    fs::rename(tmp, path);
+}
+
+// ====== morphy ======
+
+bool Lemmatizer::in_index(std::string_view w, Pos pos) const {
+    const int32_t id = words_.find(w);
+    return id >= 0 && (pos_[id] & pos);
+}
+
+// NLTK WordNetCorpusReader._morphy (3.9 이후) 와 같은 단계
+//   0) 예외 목록에 있으면 [form] + 예외 원형 중 색인에 있는 것만
+//   1) 아니면 규칙을 한 번만 적용 → [form] + 결과 중 색인에 있는 것
+//      (예전 NLTK 는 못 찾으면 규칙을 반복 적용했지만 지금은 하지 않음: glasseses → 분석 없음)
+void Lemmatizer::morphy_pos(std::string_view form, Pos pos, std::vector<std::string>& out) const {
+    out.clear();
+    auto filter = [&](const std::vector<std::string>& forms) {
+        for (const auto& f : forms) {
+            if (in_index(f, pos) && std::find(out.begin(), out.end(), f) == out.end())
+                out.push_back(f);
+        }
+    };
+
+    const int32_t id = words_.find(form);
+    if (id >= 0) {
+        std::vector<std::string> cand;
+        for (uint32_t k = exc_off_[id]; k < exc_off_[id + 1]; ++k) {
+            if ((exc_[k] >> 28) != pos) continue;
+            if (cand.empty()) cand.emplace_back(form);
+            cand.emplace_back(words_.word(exc_[k] & 0x0FFFFFFFu));
+        }
+        if (!cand.empty()) { filter(cand); return; }
+    }
+
+    std::vector<std::string> forms = apply_rules({ std::string(form) }, rules_for(pos));
+    forms.insert(forms.begin(), std::string(form));
+    filter(forms);
+}
+
+bool Lemmatizer::morphy(std::string_view form, std::string& out) const {
+    std::vector<std::string> got;
+    for (Pos p : kMorphyOrder) {
+        morphy_pos(form, p, got);
+        if (!got.empty()) { out = std::move(got.front()); return true; }
+    }
+    return false;
+}
+
+// lemmatize_list.py 의 2) 단계(WordNetLemmatizer 를 VERB/NOUN/ADJ/ADV 순으로)는
+// morphy 가 실패했다면 모든 품사에서 _morphy 가 빈 목록이라는 뜻이므로 항상 token 을 돌려준다.
+std::string Lemmatizer::lemma_of(std::string_view token) const {
+    std::string out;
+    if (morphy(token, out)) return out;
+    return std::string(token);
+}
+
+// ====== 파이프라인 진입점 ======
+
+const Lemmatizer* default_lemmatizer() {
+    static const Lemmatizer lem = load_table_auto();
+    return lem.empty() ? nullptr : &lem;
+}
+
+int compile_lemma_image() {
+    const auto p = locate_data_file(kTableTxt);
+    if (p.empty()) {
+        std::cerr << "[warn] cannot find " << kTableTxt << " (tried CWD and exe dir; see py/lemma_dump.py)\n";
+        return 0;
+    }
+    Lemmatizer lem = rebuild_image(p, Lemmatizer::from_table);
+    std::cout << "[info] compiled " << lem.size() << " lemma entries → "
+              << image_path_for(p).string() << "\n";
+    return 1;
+}
+
+int lemmatize_vocab_file(const Lemmatizer& lem, const fs::path& vocab_txt, const fs::path& out_txt,
+                         const ZipfTable* zipf, double max_zipf) {
+    std::vector<std::string> lemmas;
+    for (const auto& w : read_vocab_words(vocab_txt)) lemmas.push_back(lem.lemma_of(w));
+    std::sort(lemmas.begin(), lemmas.end());
+    lemmas.erase(std::unique(lemmas.begin(), lemmas.end()), lemmas.end());
+    if (zipf && max_zipf > 0) zipf->filter(lemmas, max_zipf);
+
+    if (out_txt.has_parent_path()) fs::create_directories(out_txt.parent_path());
+    std::ofstream out(out_txt, std::ios::binary);
+    if (!out) throw std::runtime_error("failed to create: " + out_txt.string());
+    out << lemmas.size() << "\n";
+    if (lemmas.empty()) out << "\n";
+    for (const auto& l : lemmas) out << l << '\n';
+    return (int)lemmas.size();
+}
+
+int lemmatize_vocab(const fs::path& exe_dir_in, const fs::path& vocab_txt, const fs::path& out_txt) {
+    const fs::path dir   = exe_dir_in.empty() ? exe_dir() : exe_dir_in;
+    const fs::path vocab = vocab_txt.empty() ? (dir / "vocab.txt") : vocab_txt;
+    const fs::path out   = out_txt.empty()   ? (dir / "vocab_lemma.txt") : out_txt;
+
+    const Lemmatizer* lem = default_lemmatizer();
+    if (!lem) {
+        std::cerr << "[warn] " << kTableTxt << " not found — falling back to py/lemmatize_list.py\n";
+        return run_lemmatizer(dir, vocab, out);
+    }
+    if (!fs::exists(vocab)) {
+        std::cerr << "[warn] not found: " << vocab.string() << "\n";
+        return 1;
+    }
+
+    const ZipfTable* zipf = max_zipf() > 0 ? default_zipf_table() : nullptr;
+    if (max_zipf() > 0 && !zipf)
+        std::cerr << "[warn] zipf_en.txt not found — writing lemmas without the Zipf filter (see py/zipf_dump.py)\n";
+
+    const auto t0 = std::chrono::steady_clock::now();
+    try {
+        const int n = lemmatize_vocab_file(*lem, vocab, out, zipf, max_zipf());
+        std::cout << "[ok] wrote " << out.string() << " (" << n << " lemmas, "
+                  << std::fixed << std::setprecision(1) << ms_since(t0) << " ms)\n";
+    } catch (const std::exception& e) {
+        std::cerr << "[error] lemmatizer: " << e.what() << "\n";
+        return 3;
+    }
+    return 0;
+}
+
+bool verify_lemmatizer(const fs::path& ref_tsv) {
+    const Lemmatizer* lem = default_lemmatizer();
+    if (!lem) {
+        std::cerr << "[error] " << kTableTxt << " not found (see py/lemma_dump.py)\n";
+        return false;
+    }
+    return verify_lemmatizer(*lem, ref_tsv);
+}
+
+bool verify_lemmatizer(const Lemmatizer& lem, const fs::path& ref_tsv) {
+    std::ifstream in(ref_tsv, std::ios::binary);
+    if (!in) {
+        std::cerr << "[error] cannot open: " << ref_tsv.string() << "\n";
+        return false;
+    }
+
+    size_t total = 0, bad = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        const size_t tab = line.find('\t');
+        if (line.empty() || line[0] == '#' || tab == std::string::npos) continue;
+        const std::string word = line.substr(0, tab);
+        const std::string want = line.substr(tab + 1);
+        const std::string got  = lem.lemma_of(word);
+        ++total;
+        if (got != want && ++bad <= 20)
+            std::cout << "    mismatch: " << word << " → " << got << " (python: " << want << ")\n";
+    }
+    std::cout << "    - " << total << " words, " << bad << " mismatches\n";
+    return total > 0 && bad == 0;
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mmap_file.hpp"
+#include "../../word_extractor/src/wordlist_image.hpp"
+
+class ZipfTable;
+
+// py/lemmatize_list.py 의 lemma_of 를 프로세스 안에서 그대로 재현하는 WordNet morphy
+//
+// 표 원본 wordnet_lemma.txt (py/lemma_dump.py 가 NLTK WordNet 에서 뽑아 냄)
+//   L <tab> lemma <tab> 품사들("nvar" 중 일부)      : WordNet 색인에 있는 표제어
+//   E <tab> 품사 <tab> 변화형 <tab> 원형 [<tab> 원형...] : 불규칙 변화 예외 목록 (*.exc)
+//
+// 바이너리 이미지 wordnet_lemma.bin (리틀 엔디언, 4바이트 정렬)
+//   Header                    : magic, version, words_size, exc_count
+//   WordList image[words_size] : 표제어 ∪ 예외 변화형 ∪ 예외 원형 (id = 정렬 순서)
+//   uint8  pos[count]          : 그 문자열이 색인에 있는 품사 비트 (0 = 예외 목록에만 있음)
+//   uint32 exc_off[count + 1]  : 변화형 id 별 예외 구간
+//   uint32 exc[exc_count]      : (품사 비트 << 28) | 원형 id, 예외 파일 순서 유지
+class Lemmatizer {
+public:
+    enum Pos : uint8_t { kNoun = 1, kVerb = 2, kAdj = 4, kAdv = 8 };
+
+    Lemmatizer() = default;
+
+    // 텍스트 표를 파싱해 메모리 이미지를 만든다. 형식 오류는 예외(std::runtime_error)
+    static Lemmatizer from_table(const std::filesystem::path& txt);
+    // 이미지 파일을 mmap 으로 연다. 형식이 맞지 않으면 예외(std::runtime_error)
+    static Lemmatizer open_image(const std::filesystem::path& path);
+    // 현재 이미지를 파일로 저장 (임시 파일 → rename)
+    void save_image(const std::filesystem::path& path) const;
+
+    // lemma_of(token): morphy(품사 없이) 결과, 없으면 token 그대로
+    std::string lemma_of(std::string_view token) const;
+    // wn.morphy(form): NOUN, VERB, ADJ, ADV 순서로 첫 분석 결과 (없으면 false)
+    bool morphy(std::string_view form, std::string& out) const;
+    // wn._morphy(form, pos): 해당 품사의 분석 결과 전부 (NLTK 3.9+ 와 같은 순서, 규칙은 한 번만 적용)
+    void morphy_pos(std::string_view form, Pos pos, std::vector<std::string>& out) const;
+
+    size_t size() const { return words_.size(); }
+    bool empty() const { return words_.empty(); }
+    bool mapped() const { return !map_.empty(); }
+
+private:
+    void bind(const char* base, size_t size);
+    bool in_index(std::string_view w, Pos pos) const;
+
+    MappedFile  map_;               // mmap 백업 (open_image)
+    std::vector<uint32_t> owned_;   // 메모리 백업 (from_table)
+    const char* image_ = nullptr;
+    size_t      image_size_ = 0;
+
+    WordList        words_;
+    const uint8_t*  pos_ = nullptr;
+    const uint32_t* exc_off_ = nullptr;
+    const uint32_t* exc_ = nullptr;
+};
+
+// exe 옆(또는 CWD)의 wordnet_lemma.bin/.txt 를 한 번만 열어 둔 인스턴스 (표가 없으면 nullptr)
+const Lemmatizer* default_lemmatizer();
+
+// wordnet_lemma.txt → .bin 재생성. return: 만든 이미지 수 (0 = 표 없음)
+int compile_lemma_image();
+
+// vocab.txt → vocab_lemma.txt (lemmatize_list.py 와 같은 형식: 첫 줄 개수, 이어서 정렬된 원형)
+// zipf 가 주어지고 max_zipf > 0 이면 filter_by_zipf 처럼 zipf >= max_zipf 인 원형을 뺀다
+// return: 원형 개수
+int lemmatize_vocab_file(const Lemmatizer& lem,
+                         const std::filesystem::path& vocab_txt,
+                         const std::filesystem::path& out_txt,
+                         const ZipfTable* zipf = nullptr, double max_zipf = 0);
+
+// run_lemmatizer 대체: 표가 있으면 프로세스 안에서, 없으면 파이썬 스크립트로 폴백
+// Zipf 필터는 zipf_en 표와 max_zipf() 임계값 사용 (표가 없으면 경고 후 생략)
+// return: 0 = 성공 (run_lemmatizer 와 같은 규약)
+int lemmatize_vocab(const std::filesystem::path& exe_dir,
+                    const std::filesystem::path& vocab_txt = {},
+                    const std::filesystem::path& out_txt   = {});
+
+// py/lemma_dump.py --ref 로 만든 "단어<tab>파이썬 lemma" 파일과 결과 비교 (불일치 출력)
+bool verify_lemmatizer(const std::filesystem::path& ref_tsv);                         // default_lemmatizer()
+bool verify_lemmatizer(const Lemmatizer& lem, const std::filesystem::path& ref_tsv);
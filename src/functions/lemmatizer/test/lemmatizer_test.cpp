@@ -0,0 +1,70 @@
+#include "lemmatizer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// ---- 레마타이저: 파이썬 lemma_of 와의 차이 비교 ----
+// test/ 의 데이터는 py/lemma_dump.py 로 만든 것
+//   wordnet_lemma_subset.txt : --words lemma_words.txt (그 단어들을 분석할 때 조회되는 WordNet 항목만)
+//   lemma_ref.tsv            : --ref lemma_words.txt   (lemmatize_list.lemma_of 결과)
+
+namespace {
+
+const fs::path kDataDir = EPUB2VOCAB_LEMMATIZER_TEST_DIR;
+
+Lemmatizer load_subset() {
+    return Lemmatizer::from_table(kDataDir / "wordnet_lemma_subset.txt");
+}
+
+} // namespace
+
+TEST(Lemmatizer, MatchesPythonReference) {
+    const Lemmatizer lem = load_subset();
+    ASSERT_FALSE(lem.empty());
+    EXPECT_TRUE(verify_lemmatizer(lem, kDataDir / "lemma_ref.tsv"));
+}
+
+TEST(Lemmatizer, MappedImageMatchesPythonReference) {
+    // 이미지로 저장 → mmap 으로 다시 열어도 같은 결과
+    const fs::path img = fs::temp_directory_path() / "epub2vocab_lemmatizer_test.bin";
+    load_subset().save_image(img);
+    {
+        const Lemmatizer mapped = Lemmatizer::open_image(img);
+        EXPECT_TRUE(mapped.mapped());
+        EXPECT_TRUE(verify_lemmatizer(mapped, kDataDir / "lemma_ref.tsv"));
+    }
+    fs::remove(img);
+}
+
+TEST(Lemmatizer, RulesApplyOnce) {
+    // NLTK 3.9+ 의 _morphy 는 규칙을 한 번만 적용한다 (glasseses → glasses → glass 로 이어 가지 않음)
+    const Lemmatizer lem = load_subset();
+    EXPECT_EQ(lem.lemma_of("glasses"), "glass");
+    EXPECT_EQ(lem.lemma_of("glasseses"), "glasseses");
+}
+
+TEST(Lemmatizer, ExceptionListWinsOverRules) {
+    // 예외 목록에 있는 품사에서는 규칙을 쓰지 않는다 (axes: ax 가 axis 보다 먼저, 파일 순서)
+    const Lemmatizer lem = load_subset();
+    std::vector<std::string> got;
+    lem.morphy_pos("axes", Lemmatizer::kNoun, got);
+    EXPECT_EQ(got, (std::vector<std::string>{ "ax", "axis" }));
+    EXPECT_EQ(lem.lemma_of("geese"), "goose");
+    EXPECT_EQ(lem.lemma_of("xyzzy"), "xyzzy");
+}
+
+TEST(Lemmatizer, RejectsMalformedTable) {
+    const fs::path bad = fs::temp_directory_path() / "epub2vocab_lemmatizer_bad.txt";
+    {
+        std::ofstream out(bad, std::ios::binary);
+        out << "L\tchurch\tnv\nX\tbroken\n";
+    }
+    EXPECT_THROW(Lemmatizer::from_table(bad), std::runtime_error);
+    fs::remove(bad);
+}
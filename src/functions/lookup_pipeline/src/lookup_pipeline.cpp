@@ -0,0 +1,236 @@
+#include "lookup_pipeline.hpp"
+#include "../../connect_dictionary/src/connect_dictionary.hpp"
+#include "../../lemmatizer/src/lemmatizer.hpp"
+#include "../../word_extractor/src/word_extractor.hpp"
+#include "../../zipf_filter/src/zipf_filter.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+
+namespace {
+
+uint64_t splitmix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+} // namespace
+
+LookupPipeline::LookupPipeline(Options opt) : opt_(opt) {
+    enabled_ = opt_.k > 0 && default_lemmatizer() != nullptr;
+    if (enabled_) io_ = std::thread([this] { run(); });
+}
+
+LookupPipeline::~LookupPipeline() {
+    stop();
+}
+
+void LookupPipeline::stop() {
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        closing_ = true;
+    }
+    cv_.notify_all();
+    if (io_.joinable()) io_.join();
+}
+
+uint64_t LookupPipeline::priority(const std::string& lemma) const {
+    uint64_t h = 1469598103934665603ull;   // FNV-1a 64
+    for (unsigned char c : lemma) h = (h ^ c) * 1099511628211ull;
+    return splitmix64(h ^ opt_.seed);
+}
+
+void LookupPipeline::on_word(uint32_t dict_id) {
+    if (!enabled_) return;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        if (closing_) return;
+        queue_.push_back(dict_id);
+    }
+    cv_.notify_all();
+}
+
+// 조회 예약 (I/O 스레드에서만). 캐시 적중이면 콜백이 바로 불린다
+void LookupPipeline::request(const std::string& lemma) {
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        if (!entries_.emplace(lemma, Entry{}).second) return;
+        ++in_flight_;
+    }
+    const uint64_t ticket = request_definition(lemma, [this, lemma](std::string def) {
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            Entry& e = entries_[lemma];
+            e.done = true;
+            e.ticket = 0;
+            e.definition = std::move(def);
+            --in_flight_;
+        }
+        cv_.notify_all();
+    });
+    std::lock_guard<std::mutex> lk(mu_);
+    Entry& e = entries_[lemma];
+    if (!e.done) e.ticket = ticket;
+}
+
+// 끝나지 않은 조회를 취소하고 항목을 지운다. 반환: 실제로 취소했는지
+// (이미 끝났으면 결과는 그대로 둔다: 최종 목록에서 다시 뽑힐 수 있음)
+// finish 가 고른 원형(claimed_)은 취소하지 않는다. finish 가 고르기 직전에 I/O 스레드가 꺼내 간
+// 묶음이 그 원형을 bottom-k 밖으로 밀어낼 수 있기 때문. 취소와 고르기가 엇갈렸으면 급한 조회로 다시 보낸다
+bool LookupPipeline::drop(const std::string& lemma) {
+    uint64_t ticket = 0;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        if (claimed_.count(lemma)) return false;
+        auto it = entries_.find(lemma);
+        if (it == entries_.end() || it->second.done) return false;
+        ticket = it->second.ticket;
+    }
+    if (!cancel_definition(ticket)) return false;   // 그 사이 끝났음
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        entries_.erase(lemma);
+        --in_flight_;
+        ++cancelled_;
+        if (claimed_.count(lemma)) urgent_.push_back(lemma);
+    }
+    cv_.notify_all();
+    return true;
+}
+
+void LookupPipeline::run() {
+    const Lemmatizer& lem = *default_lemmatizer();
+    const double max_z = max_zipf();
+    const ZipfTable* zipf = max_z > 0 ? default_zipf_table() : nullptr;
+
+    std::vector<uint32_t> ids;
+    std::vector<std::string> fetch;
+    while (true) {
+        bool busy;
+        {
+            std::unique_lock<std::mutex> lk(mu_);
+            // 보낸 조회가 없으면 새 단어가 올 때까지 자고, 있으면 전송을 진행하러 바로 나간다
+            if (in_flight_ == 0) {
+                cv_.wait(lk, [&] { return !queue_.empty() || !urgent_.empty() || closing_; });
+            }
+            if (closing_) break;
+            ids.swap(queue_);
+            fetch.swap(urgent_);
+        }
+
+        for (uint32_t id : ids) {
+            if (!seen_ids_.insert(id).second) continue;    // 샤드마다 같은 단어가 올 수 있음
+            std::string lemma = lem.lemma_of(dictionary_word(id));
+            if (zipf && zipf->zipf(lemma) >= max_z) continue;
+            if (!seen_lemmas_.insert(lemma).second) continue;
+            if (known_miss(lemma)) continue;               // 지난 실행에서 정의가 없던 단어
+
+            const uint64_t pr = priority(lemma);
+            if (top_.size() >= opt_.k && pr >= top_.rbegin()->first) continue;
+            top_.emplace(pr, std::move(lemma));
+            if (top_.size() > opt_.k) {
+                // 밀려난 후보: 아직 안 끝난 조회면 취소하고 예산을 돌려받는다
+                auto last = std::prev(top_.end());
+                if (drop(last->second)) {
+                    std::lock_guard<std::mutex> lk(mu_);
+                    --speculative_;
+                }
+                top_.erase(last);
+            }
+        }
+        ids.clear();
+
+        // 이번 묶음을 다 본 뒤에도 남아 있는 후보만 보낸다 (묶음 안에서 밀려난 건 보내지 않음)
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            for (const auto& [pr, lemma] : top_) {
+                if (speculative_ >= opt_.max_speculative) break;
+                if (entries_.count(lemma)) continue;
+                if (std::find(fetch.begin(), fetch.end(), lemma) != fetch.end()) continue;
+                ++speculative_;
+                fetch.push_back(lemma);
+            }
+        }
+
+        for (const auto& lemma : fetch) request(lemma);
+        fetch.clear();
+
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            busy = in_flight_ > 0;
+        }
+        // 짧게 기다려야 그 사이 들어온 새 후보도 곧바로 보낼 수 있다
+        if (busy) poll_definitions(20);
+    }
+
+    // 멈출 때 아직 끝나지 않은 조회는 버린다
+    std::vector<std::string> left;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        for (const auto& [lemma, e] : entries_) {
+            if (!e.done) left.push_back(lemma);
+        }
+    }
+    for (const auto& lemma : left) drop(lemma);
+}
+
+std::vector<LookupPipeline::Pick> LookupPipeline::finish(const std::vector<std::string>& final_lemmas) {
+    std::vector<std::pair<uint64_t, const std::string*>> ranked;
+    ranked.reserve(final_lemmas.size());
+    for (const auto& l : final_lemmas) ranked.emplace_back(priority(l), &l);
+    // 우선순위가 작은 것부터 꺼내며 정의가 없다고 알려진 단어는 건너뛴다 (추출 중에 조회해 보니 미스였던 것 포함)
+    std::make_heap(ranked.begin(), ranked.end(), std::greater<>());
+    std::vector<const std::string*> chosen;
+    for (auto end = ranked.end(); chosen.size() < opt_.k && end != ranked.begin(); --end) {
+        std::pop_heap(ranked.begin(), end, std::greater<>());
+        const std::string* lemma = (end - 1)->second;
+        if (!known_miss(*lemma)) chosen.push_back(lemma);
+    }
+    const size_t k = chosen.size();
+
+    std::vector<Pick> picks(k);
+    std::vector<std::string> stale;
+    size_t reused = 0;
+    {
+        std::unique_lock<std::mutex> lk(mu_);
+        queue_.clear();                 // 추출은 끝났다: 남은 추측 후보는 더 보지 않음
+        for (size_t i = 0; i < k; ++i) {
+            picks[i].lemma = *chosen[i];
+            claimed_.insert(picks[i].lemma);
+            if (entries_.count(picks[i].lemma)) ++reused;
+            else urgent_.push_back(picks[i].lemma);
+        }
+        std::cout << "[lookup] prefetched " << speculative_ << " during extraction ("
+                  << cancelled_ << " cancelled), " << reused << "/" << k << " reused, "
+                  << urgent_.size() << " fetched now\n";
+        for (const auto& [lemma, e] : entries_) {
+            if (e.done) continue;
+            bool pick = false;
+            for (const auto& p : picks) pick = pick || p.lemma == lemma;
+            if (!pick) stale.push_back(lemma);
+        }
+    }
+    // 최종 k 개가 아닌 조회가 급한 조회 앞을 막지 않도록 먼저 취소
+    for (const auto& lemma : stale) drop(lemma);
+    cv_.notify_all();
+
+    {
+        std::unique_lock<std::mutex> lk(mu_);
+        cv_.wait(lk, [&] {
+            for (const auto& p : picks) {
+                auto it = entries_.find(p.lemma);
+                if (it == entries_.end() || !it->second.done) return false;
+            }
+            return true;
+        });
+    }
+    stop();
+
+    for (auto& p : picks) {
+        p.definition = std::move(entries_[p.lemma].definition);
+    }
+    return picks;
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// 사전 조회 단계를 I/O 스레드로 돌려 단어 추출(CPU)과 네트워크를 겹친다
+//
+// 최종 목표는 vocab_lemma.txt 에서 k 개를 고르게 뽑아 정의를 받는 것.
+// 뽑기는 "원형마다 (seed 섞은 해시) 우선순위를 매기고 가장 작은 k 개" (bottom-k) 로 한다.
+// 이러면 최종 목록이 나오기 전에도, 지금까지 본 원형 중 bottom-k 가 최종 후보이므로
+// 토크나이저가 새 단어를 찾는 즉시 원형 → Zipf 필터 → bottom-k 갱신 → 새로 들어온 후보를
+// I/O 스레드가 미리 조회할 수 있다. 후보가 밀려나면 아직 끝나지 않은 조회는 취소하고,
+// 이미 끝난 조회는 낭비지만(정의 캐시에는 남음) max_speculative 로 상한을 둔다. 조회는 비동기(request_definition + poll_definitions)라
+// 응답을 기다리는 동안에도 I/O 스레드는 새 후보를 계속 받아 보낸다.
+//
+// 원형 표(wordnet_lemma)가 없으면 enabled()==false 이고 아무 일도 하지 않는다.
+class LookupPipeline {
+public:
+    struct Options {
+        size_t   k = 5;
+        uint64_t seed = 0;
+        size_t   max_speculative = 20;   // 미리 보내는 조회 수 상한
+    };
+    struct Pick {
+        std::string lemma;
+        std::string definition;
+    };
+
+    explicit LookupPipeline(Options opt);
+    ~LookupPipeline();
+    LookupPipeline(const LookupPipeline&) = delete;
+    LookupPipeline& operator=(const LookupPipeline&) = delete;
+
+    bool enabled() const { return enabled_; }
+
+    // 토크나이저에서 새 사전 단어가 나올 때 (여러 스레드에서 동시 호출 가능, 큐에 넣기만 함)
+    void on_word(uint32_t dict_id);
+
+    // 최종 원형 목록에서 k 개를 골라 정의와 함께 돌려준다 (우선순위 순서)
+    // 미리 받았거나 받는 중인 건 재사용하고, 없는 것만 I/O 스레드에 급히 맡긴 뒤
+    // 모두 끝나면 남은 추측 조회는 취소하고 I/O 스레드를 멈춘다. 실패한 조회는 "Lookup failed: ..." 정의로 온다.
+    std::vector<Pick> finish(const std::vector<std::string>& final_lemmas);
+
+private:
+    struct Entry {
+        bool done = false;
+        uint64_t ticket = 0;            // 진행 중 조회 취소용 (0 = 없음/끝남)
+        std::string definition;
+    };
+
+    void run();
+    void stop();
+    void request(const std::string& lemma);
+    bool drop(const std::string& lemma);
+    uint64_t priority(const std::string& lemma) const;
+
+    Options opt_;
+    bool enabled_ = false;
+
+    std::mutex mu_;
+    std::condition_variable cv_;
+    std::vector<uint32_t> queue_;
+    std::vector<std::string> urgent_;                    // finish 가 추가로 맡긴 원형
+    std::unordered_map<std::string, Entry> entries_;     // 보낸 조회 (원형 → 결과)
+    std::unordered_set<std::string> claimed_;            // finish 가 고른 원형 (drop 하지 않음)
+    size_t in_flight_ = 0;
+    size_t speculative_ = 0;            // 보낸 추측 조회 (취소된 건 빼고)
+    size_t cancelled_ = 0;
+    bool closing_ = false;
+    std::thread io_;
+
+    // 아래는 I/O 스레드 전용
+    std::unordered_set<uint32_t> seen_ids_;
+    std::unordered_set<std::string> seen_lemmas_;
+    std::set<std::pair<uint64_t, std::string>> top_;     // 지금까지의 bottom-k
+};
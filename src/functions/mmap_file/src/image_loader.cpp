@@ -0,0 +1,45 @@
+#include "image_loader.hpp"
+
+#ifdef _WIN32
+  #include <windows.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+fs::path exe_dir() {
+#ifdef _WIN32
+    wchar_t buf[MAX_PATH];
+    DWORD n = GetModuleFileNameW(nullptr, buf, MAX_PATH);
+    return n ? fs::path(buf).parent_path() : fs::current_path();
+#else
+    return fs::current_path();
+#endif
+}
+
+} // namespace
+
+fs::path locate_data_file(const fs::path& name) {
+    const fs::path cand1 = fs::current_path() / name; // CWD
+    if (fs::exists(cand1)) return cand1;
+    const fs::path cand2 = exe_dir() / name;          // exe 옆
+    if (fs::exists(cand2)) return cand2;
+    return {};
+}
+
+fs::path image_path_for(const fs::path& txt) {
+    fs::path p = txt;
+    p.replace_extension(".bin");
+    return p;
+}
+
+bool image_is_fresh(const fs::path& img, const fs::path& txt) {
+    std::error_code ec;
+    if (!fs::exists(img, ec)) return false;
+    if (txt.empty()) return true;
+    const auto ti = fs::last_write_time(img, ec);
+    if (ec) return false;
+    const auto tt = fs::last_write_time(txt, ec);
+    return ec || ti >= tt;
+}
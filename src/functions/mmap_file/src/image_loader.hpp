@@ -0,0 +1,64 @@
+#pragma once
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+// 텍스트 표 + 바이너리 이미지 로더 공통 규칙 (words/stopwords, zipf, lemma, offline dictionary)
+// - 파일은 CWD → exe 옆 순서로 찾는다
+// - 이미지(.bin)가 텍스트보다 새로우면 mmap, 아니면 텍스트 재파싱 + 이미지 재생성
+// - 이미지 저장 실패는 경고만 (메모리의 결과는 그대로 사용)
+
+// CWD → exe 옆 순서로 찾음. 못 찾으면 빈 경로
+std::filesystem::path locate_data_file(const std::filesystem::path& name);
+
+// 텍스트 옆의 이미지 경로 (words.txt → words.bin)
+std::filesystem::path image_path_for(const std::filesystem::path& txt);
+
+// img 가 있고 txt 보다 오래되지 않았는지 (txt 가 비어 있으면 존재만 확인)
+bool image_is_fresh(const std::filesystem::path& img, const std::filesystem::path& txt);
+
+// parse(txt) 로 만들고 image_path_for(txt) 에 save_image (실패는 경고)
+template <class Parse>
+auto rebuild_image(const std::filesystem::path& txt, Parse parse) {
+    auto t = parse(txt);
+    const auto img = image_path_for(txt);
+    try {
+        t.save_image(img);
+    } catch (const std::exception& e) {
+        std::cerr << "[warn] cannot write " << img.string() << ": " << e.what() << "\n";
+    }
+    return t;
+}
+
+// txt_name/bin_name 을 찾아 mmap(open) 또는 재생성(parse). 둘 다 없거나 실패하면 기본값.
+// source 에 어디서 읽었는지 ("... (mapped)" / "... (image rebuilt)") 를 남긴다. 못 읽었으면 빈 문자열
+template <class Parse, class Open>
+auto load_or_rebuild_image(const char* txt_name, const char* bin_name, Parse parse, Open open,
+                           std::string* source = nullptr) {
+    using T = decltype(parse(std::filesystem::path{}));
+    const auto p = locate_data_file(txt_name);
+    const auto img = p.empty() ? locate_data_file(bin_name) : image_path_for(p);
+
+    T t{};
+    std::string src;
+    if (!img.empty() && image_is_fresh(img, p)) {
+        try {
+            t = open(img);
+            src = img.string() + " (mapped)";
+        } catch (const std::exception& e) {
+            std::cerr << "[warn] " << img.string() << ": " << e.what() << " — falling back to " << txt_name << "\n";
+        }
+    }
+    if (src.empty() && !p.empty()) {
+        try {
+            t = rebuild_image(p, parse);
+            src = p.string() + " (image rebuilt)";
+        } catch (const std::exception& e) {
+            std::cerr << "[warn] " << p.string() << ": " << e.what() << "\n";
+            t = T{};
+        }
+    }
+    if (source) *source = std::move(src);
+    return t;
+}
@@ -0,0 +1,83 @@
+#include "mmap_file.hpp"
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::filesystem::path& path) {
+#ifdef _WIN32
+    HANDLE f = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (f == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("cannot open: " + path.string());
+    file_ = f;
+
+    LARGE_INTEGER sz;
+    if (!GetFileSizeEx(f, &sz)) { close(); throw std::runtime_error("GetFileSizeEx failed: " + path.string()); }
+    size_ = static_cast<size_t>(sz.QuadPart);
+    if (size_ == 0) return;
+
+    HANDLE m = CreateFileMappingW(f, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m) { close(); throw std::runtime_error("CreateFileMapping failed: " + path.string()); }
+    mapping_ = m;
+
+    void* v = MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0);
+    if (!v) { close(); throw std::runtime_error("MapViewOfFile failed: " + path.string()); }
+    data_ = static_cast<const char*>(v);
+#else
+    fd_ = ::open(path.c_str(), O_RDONLY);
+    if (fd_ < 0)
+        throw std::runtime_error("cannot open: " + path.string());
+
+    struct stat st;
+    if (::fstat(fd_, &st) != 0) { close(); throw std::runtime_error("fstat failed: " + path.string()); }
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ == 0) return;
+
+    void* v = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+    if (v == MAP_FAILED) { close(); throw std::runtime_error("mmap failed: " + path.string()); }
+    data_ = static_cast<const char*>(v);
+#endif
+}
+
+MappedFile::~MappedFile() { close(); }
+
+MappedFile::MappedFile(MappedFile&& o) noexcept { *this = std::move(o); }
+
+MappedFile& MappedFile::operator=(MappedFile&& o) noexcept {
+    if (this != &o) {
+        close();
+        std::swap(data_, o.data_);
+        std::swap(size_, o.size_);
+#ifdef _WIN32
+        std::swap(file_, o.file_);
+        std::swap(mapping_, o.mapping_);
+#else
+        std::swap(fd_, o.fd_);
+#endif
+    }
+    return *this;
+}
+
+void MappedFile::close() {
+#ifdef _WIN32
+    if (data_)    UnmapViewOfFile(data_);
+    if (mapping_) CloseHandle(static_cast<HANDLE>(mapping_));
+    if (file_)    CloseHandle(static_cast<HANDLE>(file_));
+    file_ = mapping_ = nullptr;
+#else
+    if (data_)    ::munmap(const_cast<char*>(data_), size_);
+    if (fd_ >= 0) ::close(fd_);
+    fd_ = -1;
+#endif
+    data_ = nullptr;
+    size_ = 0;
+}
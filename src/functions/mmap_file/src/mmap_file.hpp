@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+
+// 읽기 전용 메모리 매핑 파일 (RAII, 이동만 가능)
+// - Windows: CreateFileMappingW / MapViewOfFile
+// - 그 외: mmap(PROT_READ, MAP_PRIVATE)
+// 오류 시 예외(std::runtime_error) 발생. 크기 0 파일은 data()==nullptr.
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::filesystem::path& path);
+    ~MappedFile();
+
+    MappedFile(MappedFile&& o) noexcept;
+    MappedFile& operator=(MappedFile&& o) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+private:
+    void close();
+
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    void* file_ = nullptr;
+    void* mapping_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+};
@@ -0,0 +1,109 @@
+#include "image_loader.hpp"
+#include "mmap_file.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace fs = std::filesystem;
+
+// ---- 텍스트/이미지 공통 로더: 신선도 판정과 재생성 ----
+// 이미지 형식 대신 "텍스트 내용을 그대로 복사" 하는 장난감 표로 규칙만 확인
+
+namespace {
+
+struct Table {
+    std::string body;
+    bool mapped = false;
+
+    static Table parse(const fs::path& txt) {
+        std::ifstream in(txt, std::ios::binary);
+        if (!in) throw std::runtime_error("cannot open: " + txt.string());
+        return { std::string(std::istreambuf_iterator<char>(in), {}), false };
+    }
+    static Table open(const fs::path& img) {
+        MappedFile m(img);
+        if (m.empty()) throw std::runtime_error("empty image");
+        return { std::string(m.data(), m.size()), true };
+    }
+    void save_image(const fs::path& img) const {
+        std::ofstream(img, std::ios::binary) << body;
+    }
+};
+
+class ImageLoader : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir_ = fs::temp_directory_path() / "epub2vocab_image_loader_test";
+        fs::remove_all(dir_);
+        fs::create_directories(dir_);
+        old_cwd_ = fs::current_path();
+        fs::current_path(dir_);
+    }
+    void TearDown() override {
+        std::error_code ec;
+        fs::current_path(old_cwd_, ec);
+        fs::remove_all(dir_, ec);
+    }
+    static void write(const char* name, const std::string& body) {
+        std::ofstream(name, std::ios::binary) << body;
+    }
+    static Table load(std::string* source) {
+        return load_or_rebuild_image("table.txt", "table.bin", Table::parse, Table::open, source);
+    }
+
+    fs::path dir_, old_cwd_;
+};
+
+} // namespace
+
+TEST_F(ImageLoader, RebuildsMissingImageThenMapsIt) {
+    write("table.txt", "alpha");
+    std::string source;
+    Table t = load(&source);
+    EXPECT_EQ(t.body, "alpha");
+    EXPECT_FALSE(t.mapped);
+    EXPECT_NE(source.find("(image rebuilt)"), std::string::npos);
+    ASSERT_TRUE(fs::exists("table.bin"));
+
+    t = load(&source);
+    EXPECT_EQ(t.body, "alpha");
+    EXPECT_TRUE(t.mapped);
+    EXPECT_NE(source.find("(mapped)"), std::string::npos);
+}
+
+TEST_F(ImageLoader, StaleImageIsRebuilt) {
+    write("table.bin", "old");
+    write("table.txt", "new");
+    fs::last_write_time("table.bin", fs::last_write_time("table.txt") - std::chrono::hours(1));
+    Table t = load(nullptr);
+    EXPECT_EQ(t.body, "new");
+    EXPECT_FALSE(t.mapped);
+}
+
+TEST_F(ImageLoader, ImageAloneIsMapped) {
+    write("table.bin", "only");
+    Table t = load(nullptr);
+    EXPECT_EQ(t.body, "only");
+    EXPECT_TRUE(t.mapped);
+}
+
+TEST_F(ImageLoader, BadImageFallsBackToText) {
+    write("table.txt", "text");
+    write("table.bin", "");   // open 이 던짐
+    fs::last_write_time("table.bin", fs::last_write_time("table.txt") + std::chrono::hours(1));
+    Table t = load(nullptr);
+    EXPECT_EQ(t.body, "text");
+    EXPECT_FALSE(t.mapped);
+}
+
+TEST_F(ImageLoader, NothingFound) {
+    std::string source = "x";
+    Table t = load(&source);
+    EXPECT_TRUE(t.body.empty());
+    EXPECT_TRUE(source.empty());
+    EXPECT_TRUE(locate_data_file("table.txt").empty());
+}
@@ -0,0 +1,137 @@
+#include "delivery_queue.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <unordered_set>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const char kMagic[4] = { 'E','2','T','Q' };
+const uint8_t kPush = 1;
+const uint8_t kAck = 2;
+
+struct RecordHeader {
+    char     magic[4];
+    uint8_t  type;
+    uint8_t  reserved[3];
+    uint32_t size;
+    uint32_t check;        // FNV-1a(payload): 끝이 잘린/깨진 레코드 감지용
+    uint64_t id;
+};
+static_assert(sizeof(RecordHeader) == 24, "unexpected RecordHeader padding");
+
+const uint32_t kMaxPayload = 16u << 20;
+
+uint32_t fnv1a(const std::string& s) {
+    uint32_t h = 2166136261u;
+    for (unsigned char c : s) h = (h ^ c) * 16777619u;
+    return h;
+}
+
+void write_record(std::ostream& out, uint8_t type, uint64_t id, const std::string& payload) {
+    RecordHeader h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.type = type;
+    h.size = (uint32_t)payload.size();
+    h.id = id;
+    h.check = fnv1a(payload);
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    out.write(payload.data(), (std::streamsize)payload.size());
+}
+
+std::string make_payload(const std::string& chat_id, const std::string& text) {
+    std::string p = chat_id;
+    p += '\0';
+    p += text;
+    return p;
+}
+
+} // namespace
+
+DeliveryQueue::DeliveryQueue(fs::path path) : path_(std::move(path)) {
+    load();
+    rewrite();
+}
+
+// 저널을 처음부터 읽어 아직 ack 되지 않은 push 만 모은다
+void DeliveryQueue::load() {
+    std::error_code ec;
+    if (!fs::exists(path_, ec)) return;
+    std::ifstream in(path_, std::ios::binary);
+    if (!in) {
+        std::cerr << "[warn] cannot open telegram queue: " << path_.string() << "\n";
+        return;
+    }
+
+    std::vector<Item> pushed;
+    std::unordered_set<uint64_t> acked;
+    std::string payload;
+    while (true) {
+        RecordHeader h;
+        if (!in.read(reinterpret_cast<char*>(&h), sizeof(h))) break;
+        if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0 || h.size > kMaxPayload) break;
+        payload.resize(h.size);
+        if (!in.read(payload.data(), h.size) || fnv1a(payload) != h.check) break;
+
+        next_id_ = std::max(next_id_, h.id + 1);
+        if (h.type == kAck) {
+            acked.insert(h.id);
+        } else if (h.type == kPush) {
+            const size_t nul = payload.find('\0');
+            if (nul == std::string::npos) continue;
+            pushed.push_back({ h.id, payload.substr(0, nul), payload.substr(nul + 1) });
+        }
+    }
+    for (auto& it : pushed) {
+        if (!acked.count(it.id)) items_.push_back(std::move(it));
+    }
+    if (!items_.empty())
+        std::cout << "[info] telegram: " << items_.size() << " undelivered message(s) from a previous run\n";
+}
+
+// 남은 메시지만으로 저널을 다시 쓴다 (임시 파일 → rename), 이후 추가 모드로 연다
+void DeliveryQueue::rewrite() {
+    log_.close();
+    std::error_code ec;
+    if (path_.has_parent_path()) fs::create_directories(path_.parent_path(), ec);
+    const fs::path tmp = path_.string() + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        for (const auto& it : items_) write_record(out, kPush, it.id, make_payload(it.chat_id, it.text));
+        if (!out) {
+            std::cerr << "[warn] cannot write telegram queue: " << tmp.string() << "\n";
+            return;
+        }
+    }
+    fs::rename(tmp, path_, ec);
+    if (ec) {
+        std::cerr << "[warn] cannot replace telegram queue: " << ec.message() << "\n";
+        return;
+    }
+    log_.open(path_, std::ios::binary | std::ios::app);
+}
+
+void DeliveryQueue::append(uint8_t type, uint64_t id, const std::string& payload) {
+    if (!log_.is_open()) return;    // 파일 오류: 메모리 대기열만으로 동작
+    write_record(log_, type, id, payload);
+    log_.flush();
+}
+
+uint64_t DeliveryQueue::push(const std::string& chat_id, const std::string& text) {
+    const uint64_t id = next_id_++;
+    append(kPush, id, make_payload(chat_id, text));
+    items_.push_back({ id, chat_id, text });
+    return id;
+}
+
+void DeliveryQueue::pop_front() {
+    if (items_.empty()) return;
+    const uint64_t id = items_.front().id;
+    items_.pop_front();
+    if (items_.empty()) rewrite();       // 다 보냈으면 파일을 비운다
+    else append(kAck, id, std::string());
+}
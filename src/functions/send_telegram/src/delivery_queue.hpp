@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+// 텔레그램으로 보낼 메시지의 영구 대기열 (보내기 전에 프로세스가 죽어도 다음 실행에서 이어 보냄)
+//
+// 추가 전용 저널 파일
+//   레코드 = RecordHeader(magic, type, size, check, id) + payload
+//   type 1 = push (payload = chat_id '\0' text), type 2 = ack (payload 없음, id 의 메시지 전송 완료)
+// 열 때 push 중 ack 가 없는 것만 남기고 파일을 다시 쓴다. 끝이 깨진 레코드는 버린다.
+// 대기열이 비면 파일을 비운다. 스레드 안전하지 않음 (TelegramSender 가 잠금을 잡고 부른다).
+class DeliveryQueue {
+public:
+    struct Item {
+        uint64_t id = 0;
+        std::string chat_id;
+        std::string text;
+    };
+
+    explicit DeliveryQueue(std::filesystem::path path);
+
+    // 저널에 기록(flush)한 뒤 대기열 끝에 추가, 반환: id
+    uint64_t push(const std::string& chat_id, const std::string& text);
+    const Item* front() const { return items_.empty() ? nullptr : &items_.front(); }
+    // 맨 앞 메시지 완료 (보냈거나 버림)
+    void pop_front();
+
+    size_t size() const { return items_.size(); }
+    bool empty() const { return items_.empty(); }
+
+private:
+    void load();
+    void rewrite();
+    void append(uint8_t type, uint64_t id, const std::string& payload);
+
+    std::filesystem::path path_;
+    std::ofstream log_;
+    std::deque<Item> items_;
+    uint64_t next_id_ = 1;
+};
@@ -7,6 +7,7 @@
 #include <unordered_map>
 
 #include "send_telegram.hpp"
+#include "telegram_sender.hpp"
 
 #ifdef _WIN32
   #include <windows.h>
@@ -67,47 +68,42 @@ std::string TELEGRAM_API_KEY = envTelegram["TELEGRAM_API_KEY"];
 std::string TELEGRAM_CHAT_ID = envTelegram["TELEGRAM_CHAT_ID"];
 
 
-// 1) sendMessage: 긴 텍스트는 4096자 단위로 분할 전송
+// .env 의 숫자 설정값 (없거나 잘못되면 기본값)
+static double env_number(const char* key, double fallback) {
+    auto it = envTelegram.find(key);
+    if (it == envTelegram.end() || it->second.empty()) return fallback;
+    try { return std::stod(it->second); } catch (...) { return fallback; }
+}
+
+// 프로세스에 하나인 전송기 (연결 재사용, 대기열은 exe 옆 telegram_queue.log)
+// TELEGRAM_API_URL: 테스트용 로컬 서버 주소 (기본 https://api.telegram.org)
+// TELEGRAM_MIN_INTERVAL_MS: 같은 채팅 전송 간격 (기본 1000)
+static TelegramSender& telegram_sender() {
+    static TelegramSender sender([] {
+        TelegramSender::Options opt;
+        if (!envTelegram["TELEGRAM_API_URL"].empty()) opt.api_url = envTelegram["TELEGRAM_API_URL"];
+        opt.token = TELEGRAM_API_KEY;
+        opt.queue_path = exe_dir() / "telegram_queue.log";
+        opt.min_interval_ms = (long)env_number("TELEGRAM_MIN_INTERVAL_MS", 1000);
+        return opt;
+    }());
+    return sender;
+}
+
+// 1) sendMessage: 긴 텍스트는 줄/UTF-8 경계에서 4096자 이하로 나눠 대기열에 넣고,
+//    전송기가 한 연결로 순서대로 보낸다. 다 보낼 때까지 최대 TELEGRAM_FLUSH_TIMEOUT_S(기본 120) 기다림
+//    못 보낸 건 telegram_queue.log 에 남아 다음 실행에서 먼저 보낸다
 bool telegram_send_message(const std::string& text) {
     if (TELEGRAM_API_KEY.empty() || TELEGRAM_CHAT_ID.empty()) return false;
 
-    const size_t LIMIT = 4096;
-    size_t offset = 0;
-    bool ok_all = true;
-
-    while (offset < text.size()) {
-        std::string chunk = text.substr(offset, LIMIT);
-        offset += chunk.size();
-
-        // 엔드포인트
-        std::string url = "https://api.telegram.org/bot" + TELEGRAM_API_KEY + "/sendMessage";
-
-        CURL* curl = curl_easy_init();
-        if (!curl) return false;
-
-        // POST fields
-        std::string postfields = "chat_id=" + TELEGRAM_CHAT_ID + "&text=";
-        // URL-encode
-        char* enc = curl_easy_escape(curl, chunk.c_str(), (int)chunk.size());
-        if (!enc) { curl_easy_cleanup(curl); return false; }
-        postfields += enc;
-        curl_free(enc);
-
-        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, postfields.c_str());
-        curl_easy_setopt(curl, CURLOPT_POST, 1L);
-
-        // 보안 옵션(필요 시)
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1L);
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 2L);
-
-        CURLcode res = curl_easy_perform(curl);
-        if (res != CURLE_OK) {
-            std::cerr << "sendMessage error: " << curl_easy_strerror(res) << "\n";
-            ok_all = false;
-        }
-        curl_easy_cleanup(curl);
-    }
+    TelegramSender& sender = telegram_sender();
+    const size_t parts = sender.enqueue(TELEGRAM_CHAT_ID, text);
+    const bool ok_all = sender.flush((long)(env_number("TELEGRAM_FLUSH_TIMEOUT_S", 120) * 1000));
+    const auto st = sender.stats();
+    std::cout << "[info] telegram: queued " << parts << " message(s), " << st.sent << " sent, "
+              << st.retries << " retried, " << st.dropped << " dropped";
+    if (!ok_all) std::cout << ", " << sender.pending() << " still queued";
+    std::cout << "\n";
     return ok_all;
 }
 
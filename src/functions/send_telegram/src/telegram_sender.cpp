@@ -0,0 +1,217 @@
+#include "telegram_sender.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+
+size_t append_body(void* ptr, size_t size, size_t nmemb, void* user) {
+    static_cast<std::string*>(user)->append(static_cast<const char*>(ptr), size * nmemb);
+    return size * nmemb;
+}
+
+// UTF-8 선두 바이트 → 시퀀스 길이 (잘못된 바이트는 1)
+size_t utf8_length(unsigned char c) {
+    if (c < 0x80) return 1;
+    if ((c >> 5) == 0x6) return 2;
+    if ((c >> 4) == 0xE) return 3;
+    if ((c >> 3) == 0x1E) return 4;
+    return 1;
+}
+
+bool blank(std::string_view s) {
+    return s.find_first_not_of(" \t\r\n") == std::string_view::npos;
+}
+
+// {"ok":false,"error_code":429,...,"parameters":{"retry_after":5}}
+long parse_retry_after(const std::string& body) {
+    const size_t at = body.find("\"retry_after\":");
+    if (at == std::string::npos) return 0;
+    return std::strtol(body.c_str() + at + 14, nullptr, 10);
+}
+
+// 오류 응답의 description (없으면 본문 앞부분)
+std::string describe(const std::string& body) {
+    const size_t at = body.find("\"description\":\"");
+    if (at == std::string::npos) return body.substr(0, 200);
+    const size_t begin = at + 15;
+    return body.substr(begin, body.find('"', begin) - begin);
+}
+
+} // namespace
+
+std::vector<std::string> split_telegram_text(std::string_view text, size_t limit) {
+    std::vector<std::string> out;
+    if (limit == 0) limit = 1;
+    size_t start = 0;
+    while (start < text.size()) {
+        // 제한까지 글자 단위로 전진하면서 마지막 줄바꿈/공백 위치를 기억
+        size_t i = start, units = 0;
+        size_t last_nl = std::string_view::npos, last_sp = std::string_view::npos;
+        while (i < text.size()) {
+            size_t len = utf8_length((unsigned char)text[i]);
+            if (i + len > text.size()) len = 1;
+            const size_t u = len == 4 ? 2 : 1;      // BMP 밖 글자는 UTF-16 두 단위
+            if (units + u > limit) break;
+            if (text[i] == '\n') last_nl = i;
+            else if (text[i] == ' ') last_sp = i;
+            units += u;
+            i += len;
+        }
+        // 첫 글자도 안 들어가면 (limit 1 에 BMP 밖 글자) 그 글자 하나만으로 메시지를 만든다 (항상 전진)
+        if (i == start) {
+            const size_t len = utf8_length((unsigned char)text[i]);
+            i += i + len > text.size() ? 1 : len;
+        }
+        if (i >= text.size()) {
+            if (!blank(text.substr(start))) out.emplace_back(text.substr(start));
+            break;
+        }
+
+        // 너무 앞에서 자르면 메시지가 늘어나므로 절반 이후의 줄바꿈/공백만 쓴다
+        const size_t half = start + (i - start) / 2;
+        size_t cut = i, next = i;
+        if (last_nl != std::string_view::npos && last_nl >= half) cut = last_nl, next = last_nl + 1;
+        else if (last_sp != std::string_view::npos && last_sp >= half) cut = last_sp, next = last_sp + 1;
+
+        const std::string_view chunk = text.substr(start, cut - start);
+        if (!blank(chunk)) out.emplace_back(chunk);
+        start = next;
+    }
+    return out;
+}
+
+TelegramSender::TelegramSender(Options opt) : opt_(std::move(opt)), queue_(opt_.queue_path) {
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    curl_ = curl_easy_init();
+    if (!curl_) throw std::runtime_error("curl_easy_init failed");
+    curl_easy_setopt(curl_, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(curl_, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(curl_, CURLOPT_POST, 1L);
+    curl_easy_setopt(curl_, CURLOPT_WRITEFUNCTION, append_body);
+    curl_easy_setopt(curl_, CURLOPT_TIMEOUT_MS, opt_.timeout_ms);
+    curl_easy_setopt(curl_, CURLOPT_SSL_VERIFYPEER, 1L);
+    curl_easy_setopt(curl_, CURLOPT_SSL_VERIFYHOST, 2L);
+    const std::string url = opt_.api_url + "/bot" + opt_.token + "/sendMessage";
+    curl_easy_setopt(curl_, CURLOPT_URL, url.c_str());   // 문자열은 curl 이 복사
+
+    worker_ = std::thread([this] { run(); });
+}
+
+TelegramSender::~TelegramSender() {
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        closing_ = true;
+    }
+    cv_.notify_all();
+    if (worker_.joinable()) worker_.join();
+    if (curl_) curl_easy_cleanup(curl_);
+}
+
+size_t TelegramSender::enqueue(const std::string& chat_id, const std::string& text) {
+    const auto parts = split_telegram_text(text);
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        for (const auto& p : parts) queue_.push(chat_id, p);
+    }
+    cv_.notify_all();
+    return parts.size();
+}
+
+bool TelegramSender::flush(long timeout_ms) {
+    std::unique_lock<std::mutex> lk(mu_);
+    cv_.wait_for(lk, std::chrono::milliseconds(timeout_ms), [&] { return queue_.empty() || stalled_; });
+    return queue_.empty();
+}
+
+size_t TelegramSender::pending() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return queue_.size();
+}
+
+TelegramSender::Stats TelegramSender::stats() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return stats_;
+}
+
+// 워커 스레드에서만
+long TelegramSender::post(const DeliveryQueue::Item& item, long& retry_after, std::string& error) {
+    std::string fields = "chat_id=";
+    char* chat = curl_easy_escape(curl_, item.chat_id.c_str(), (int)item.chat_id.size());
+    char* text = curl_easy_escape(curl_, item.text.c_str(), (int)item.text.size());
+    if (chat && text) fields = fields + chat + "&text=" + text;
+    curl_free(chat);
+    curl_free(text);
+
+    std::string body;
+    curl_easy_setopt(curl_, CURLOPT_POSTFIELDS, fields.c_str());
+    curl_easy_setopt(curl_, CURLOPT_POSTFIELDSIZE, (long)fields.size());
+    curl_easy_setopt(curl_, CURLOPT_WRITEDATA, &body);
+    const CURLcode rc = curl_easy_perform(curl_);
+    curl_easy_setopt(curl_, CURLOPT_WRITEDATA, nullptr);
+    if (rc != CURLE_OK) {
+        error = curl_easy_strerror(rc);
+        return 0;
+    }
+    long status = 0;
+    curl_easy_getinfo(curl_, CURLINFO_RESPONSE_CODE, &status);
+    if (status != 200) {
+        error = describe(body);
+        retry_after = parse_retry_after(body);
+    }
+    return status;
+}
+
+void TelegramSender::run() {
+    int failures = 0;
+    while (true) {
+        DeliveryQueue::Item item;
+        {
+            std::unique_lock<std::mutex> lk(mu_);
+            cv_.wait(lk, [&] { return closing_ || (!queue_.empty() && !stalled_); });
+            if (closing_) break;
+            item = *queue_.front();
+
+            // 채팅별 최소 간격
+            auto it = last_sent_.find(item.chat_id);
+            if (it != last_sent_.end()) {
+                const auto ready = it->second + std::chrono::milliseconds(opt_.min_interval_ms);
+                if (cv_.wait_until(lk, ready, [&] { return closing_; })) break;
+            }
+        }
+
+        long retry_after = 0;
+        std::string error;
+        const long status = post(item, retry_after, error);
+        last_sent_[item.chat_id] = Clock::now();
+
+        std::unique_lock<std::mutex> lk(mu_);
+        if (status == 200) {
+            queue_.pop_front();
+            ++stats_.sent;
+            failures = 0;
+        } else if (status == 0 || status == 429 || status >= 500) {
+            ++stats_.retries;
+            if (++failures >= opt_.max_attempts) {
+                std::cerr << "[warn] telegram: giving up for now after " << failures << " attempts ("
+                          << (status ? "HTTP " + std::to_string(status) + ": " : std::string()) << error
+                          << "), " << queue_.size() << " message(s) stay queued\n";
+                stalled_ = true;
+                cv_.notify_all();
+                continue;
+            }
+            long delay_ms = std::min(opt_.backoff_cap_ms, opt_.backoff_base_ms << std::min(failures - 1, 20));
+            if (retry_after > 0) delay_ms = retry_after * 1000;
+            if (cv_.wait_for(lk, std::chrono::milliseconds(delay_ms), [&] { return closing_; })) break;
+            continue;
+        } else {
+            std::cerr << "[warn] telegram: dropped message (HTTP " << status << ": " << error << ")\n";
+            queue_.pop_front();
+            ++stats_.dropped;
+            failures = 0;
+        }
+        cv_.notify_all();
+    }
+}
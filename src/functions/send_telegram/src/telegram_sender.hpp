@@ -0,0 +1,79 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <curl/curl.h>
+
+#include "delivery_queue.hpp"
+
+// 텔레그램 메시지 길이 제한(4096, UTF-16 단위)에 맞춰 나누기
+// 줄바꿈 > 공백 > 글자 경계 순으로 자를 곳을 찾는다. UTF-8 시퀀스는 절대 가르지 않는다.
+// 자른 자리의 줄바꿈/공백 하나는 버린다
+std::vector<std::string> split_telegram_text(std::string_view text, size_t limit = 4096);
+
+// 비동기 텔레그램 전송기
+// - enqueue 는 나눠서 영구 대기열(DeliveryQueue)에 넣고 바로 돌아온다. 전송은 워커 스레드가
+// - curl easy 핸들 하나를 계속 재사용 → 연결/TLS 세션 유지 (메시지마다 핸드셰이크 없음)
+// - 같은 채팅에는 min_interval_ms 간격 이상으로 보낸다 (텔레그램 권장: 채팅당 초당 1개)
+// - 429 는 응답의 parameters.retry_after 만큼, 5xx/전송 실패는 지수 백오프 후 같은 메시지를 다시 보낸다
+//   max_attempts 번 연속 실패하면 이번 실행에서는 멈춘다 (대기열은 파일에 남아 다음 실행에서 이어 보냄)
+// - 그 밖의 4xx 는 다시 보내도 안 되므로 경고 후 버린다
+class TelegramSender {
+public:
+    struct Options {
+        std::string api_url = "https://api.telegram.org";   // 끝에 /bot<token>/sendMessage 가 붙는다
+        std::string token;
+        std::filesystem::path queue_path;
+        long min_interval_ms = 1000;
+        long timeout_ms = 30000;        // 요청 하나당
+        int  max_attempts = 5;
+        long backoff_base_ms = 1000;
+        long backoff_cap_ms = 30000;
+    };
+    struct Stats {
+        uint64_t sent = 0;
+        uint64_t retries = 0;
+        uint64_t dropped = 0;
+    };
+
+    explicit TelegramSender(Options opt);
+    // 워커를 멈춘다. 못 보낸 메시지는 대기열 파일에 남는다
+    ~TelegramSender();
+    TelegramSender(const TelegramSender&) = delete;
+    TelegramSender& operator=(const TelegramSender&) = delete;
+
+    // 반환: 나눠서 넣은 메시지 수
+    size_t enqueue(const std::string& chat_id, const std::string& text);
+    // 대기열이 빌 때까지 기다림. 비었으면 true, 시간 초과/전송 중단이면 false
+    bool flush(long timeout_ms);
+
+    size_t pending() const;
+    Stats stats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void run();
+    // 한 번 전송 시도. 반환: HTTP 상태 (전송 실패면 0), retry_after: 429 의 대기 시간(초)
+    long post(const DeliveryQueue::Item& item, long& retry_after, std::string& error);
+
+    Options opt_;
+    CURL* curl_ = nullptr;              // 워커 스레드 전용 (연결 재사용)
+    std::unordered_map<std::string, Clock::time_point> last_sent_;   // 채팅별 마지막 전송 (워커 전용)
+    mutable std::mutex mu_;
+    std::condition_variable cv_;
+    DeliveryQueue queue_;
+    Stats stats_;
+    bool stalled_ = false;              // 연속 실패로 이번 실행에서 전송 중단
+    bool closing_ = false;
+    std::thread worker_;
+};
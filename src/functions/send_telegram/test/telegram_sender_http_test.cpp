@@ -0,0 +1,283 @@
+#include "telegram_sender.hpp"
+
+#include <curl/curl.h>
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// ---- TelegramSender: py/mock_telegram_server.py 상대로 ----
+// ctest 는 mock 서버를 --run 으로 띄우고 이 실행 파일에 EPUB2VOCAB_TELEGRAM_URL (http://127.0.0.1:<port>) 을 넘긴다
+//   TelegramHttp.*  : 실패 없는 서버. 실패는 테스트마다 /fail 로 예약
+//   TelegramFlaky.* : --fail-rate 0.5 --retry-after 1 --seed 3 서버
+
+using json = nlohmann::json;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+std::string mock_url() {
+    const char* u = std::getenv("EPUB2VOCAB_TELEGRAM_URL");
+    return u ? u : "";
+}
+
+size_t append_body(void* ptr, size_t size, size_t nmemb, void* user) {
+    static_cast<std::string*>(user)->append(static_cast<const char*>(ptr), size * nmemb);
+    return size * nmemb;
+}
+
+// mock 의 GET 엔드포인트 (/stats, /messages, /fail?...)
+json mock_get(const std::string& path) {
+    std::string body;
+    CURL* curl = curl_easy_init();
+    curl_easy_setopt(curl, CURLOPT_URL, (mock_url() + path).c_str());
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, append_body);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &body);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, 5000L);
+    const CURLcode rc = curl_easy_perform(curl);
+    long status = 0;
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &status);
+    curl_easy_cleanup(curl);
+    EXPECT_EQ(rc, CURLE_OK) << curl_easy_strerror(rc);
+    EXPECT_EQ(status, 200) << path;
+    return json::parse(body.empty() ? "null" : body);
+}
+
+std::vector<std::string> texts(const json& messages) {
+    std::vector<std::string> out;
+    for (const auto& m : messages) out.push_back(m["text"].get<std::string>());
+    return out;
+}
+
+// 같은 채팅에서 이어진 두 메시지의 서버 수신 간격 중 가장 짧은 것 (초)
+double min_gap_per_chat(const json& messages) {
+    std::map<std::string, double> last;
+    double gap = 1e9;
+    for (const auto& m : messages) {
+        const std::string chat = m["chat"].get<std::string>();
+        const double t = m["t"].get<double>();
+        auto it = last.find(chat);
+        if (it != last.end()) gap = std::min(gap, t - it->second);
+        last[chat] = t;
+    }
+    return gap;
+}
+
+uint64_t by_status(const json& stats, const char* status) {
+    const json& s = stats["by_status"];
+    return s.contains(status) ? s[status].get<uint64_t>() : 0;
+}
+
+#define REQUIRE_MOCK()                                                                  \
+    do {                                                                                \
+        if (mock_url().empty()) GTEST_SKIP() << "EPUB2VOCAB_TELEGRAM_URL not set";       \
+    } while (0)
+
+// 테스트마다 새 대기열 파일 + mock 통계/메시지 초기화
+class TelegramMock : public ::testing::Test {
+protected:
+    void SetUp() override {
+        REQUIRE_MOCK();
+        const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+        path_ = fs::temp_directory_path() /
+                (std::string("epub2vocab_telegram_") + info->test_suite_name() + "_" + info->name() + ".log");
+        remove_queue();
+        mock_get("/stats/reset");
+    }
+    void TearDown() override { remove_queue(); }
+
+    void remove_queue() {
+        std::error_code ec;
+        fs::remove(path_, ec);
+        fs::remove(path_.string() + ".tmp", ec);
+    }
+
+    // 기다림을 짧게 잡은 기본 옵션 (각 테스트가 필요한 것만 바꿈)
+    TelegramSender::Options options() const {
+        TelegramSender::Options opt;
+        opt.api_url = mock_url();
+        opt.token = "test";
+        opt.queue_path = path_;
+        opt.min_interval_ms = 0;
+        opt.timeout_ms = 5000;
+        opt.max_attempts = 5;
+        opt.backoff_base_ms = 10;
+        opt.backoff_cap_ms = 100;
+        return opt;
+    }
+
+    fs::path path_;
+};
+
+class TelegramHttp : public TelegramMock {};
+class TelegramFlaky : public TelegramMock {};
+
+} // namespace
+
+TEST_F(TelegramHttp, DeliversInOrderWithPerChatMinInterval) {
+    TelegramSender::Options opt = options();
+    opt.min_interval_ms = 300;
+    TelegramSender sender(opt);
+    sender.enqueue("1", "a1");
+    sender.enqueue("1", "a2");
+    sender.enqueue("2", "b1");
+    sender.enqueue("1", "a3");
+    ASSERT_TRUE(sender.flush(10000));
+
+    const json messages = mock_get("/messages");
+    EXPECT_EQ(texts(messages), (std::vector<std::string>{ "a1", "a2", "b1", "a3" }));
+    EXPECT_GE(min_gap_per_chat(messages), 0.29);
+    // 간격은 채팅별: 다른 채팅의 b1 은 a2 를 기다리지 않는다
+    ASSERT_EQ(messages.size(), 4u);
+    EXPECT_LT(messages[2]["t"].get<double>() - messages[1]["t"].get<double>(), 0.25);
+
+    const TelegramSender::Stats st = sender.stats();
+    EXPECT_EQ(st.sent, 4u);
+    EXPECT_EQ(st.retries, 0u);
+    EXPECT_EQ(sender.pending(), 0u);
+}
+
+TEST_F(TelegramHttp, WaitsRetryAfterOn429) {
+    mock_get("/fail?status=429&count=1&retry_after=1");
+    TelegramSender sender(options());
+    const auto t0 = Clock::now();
+    sender.enqueue("1", "throttled");
+    ASSERT_TRUE(sender.flush(10000));
+    const auto elapsed = Clock::now() - t0;
+
+    // backoff_base_ms(10) 가 아니라 retry_after(1초) 만큼 기다렸어야 함
+    EXPECT_GE(elapsed, std::chrono::seconds(1));
+    const TelegramSender::Stats st = sender.stats();
+    EXPECT_EQ(st.sent, 1u);
+    EXPECT_EQ(st.retries, 1u);
+    const json s = mock_get("/stats");
+    EXPECT_EQ(s["requests"].get<uint64_t>(), 2u);
+    EXPECT_EQ(by_status(s, "429"), 1u);
+    EXPECT_EQ(texts(mock_get("/messages")), (std::vector<std::string>{ "throttled" }));
+}
+
+TEST_F(TelegramHttp, BacksOffExponentiallyOn5xx) {
+    mock_get("/fail?status=502&count=2");
+    TelegramSender::Options opt = options();
+    opt.backoff_base_ms = 150;
+    opt.backoff_cap_ms = 1000;
+    TelegramSender sender(opt);
+    const auto t0 = Clock::now();
+    sender.enqueue("1", "gateway");
+    ASSERT_TRUE(sender.flush(10000));
+    const auto elapsed = Clock::now() - t0;
+
+    // 150ms + 300ms
+    EXPECT_GE(elapsed, std::chrono::milliseconds(450));
+    const TelegramSender::Stats st = sender.stats();
+    EXPECT_EQ(st.sent, 1u);
+    EXPECT_EQ(st.retries, 2u);
+    const json s = mock_get("/stats");
+    EXPECT_EQ(s["requests"].get<uint64_t>(), 3u);
+    EXPECT_EQ(by_status(s, "502"), 2u);
+    EXPECT_EQ(texts(mock_get("/messages")), (std::vector<std::string>{ "gateway" }));
+}
+
+TEST_F(TelegramHttp, StallsAfterMaxAttemptsAndResumesNextRun) {
+    mock_get("/fail?status=502&count=3");
+    {
+        TelegramSender::Options opt = options();
+        opt.max_attempts = 3;
+        TelegramSender sender(opt);
+        sender.enqueue("1", "stuck1");
+        sender.enqueue("1", "stuck2");
+        const auto t0 = Clock::now();
+        EXPECT_FALSE(sender.flush(10000));
+        EXPECT_LT(Clock::now() - t0, std::chrono::seconds(5));   // 시간 초과가 아니라 중단으로 돌아옴
+        EXPECT_EQ(sender.pending(), 2u);
+        const TelegramSender::Stats st = sender.stats();
+        EXPECT_EQ(st.sent, 0u);
+        EXPECT_EQ(st.retries, 3u);
+        // 중단 뒤에는 더 보내지 않는다
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        EXPECT_EQ(mock_get("/stats")["requests"].get<uint64_t>(), 3u);
+    }
+
+    // 다음 실행: 같은 대기열 파일에서 이어 보냄 (예약한 실패는 다 썼다)
+    TelegramSender sender(options());
+    EXPECT_EQ(sender.pending(), 2u);
+    ASSERT_TRUE(sender.flush(10000));
+    EXPECT_EQ(texts(mock_get("/messages")), (std::vector<std::string>{ "stuck1", "stuck2" }));
+    EXPECT_EQ(sender.stats().retries, 0u);
+}
+
+TEST_F(TelegramHttp, ReplaysQueueAfterRestartWithoutDuplicates) {
+    const std::vector<std::string> sent = { "r1", "r2", "r3", "r4" };
+    {
+        TelegramSender::Options opt = options();
+        opt.min_interval_ms = 500;
+        TelegramSender sender(opt);
+        for (const auto& t : sent) sender.enqueue("1", t);
+        // 첫 메시지가 도착하면 (다음 것은 간격 대기 중) 종료
+        const auto deadline = Clock::now() + std::chrono::seconds(5);
+        while (sender.stats().sent == 0 && Clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        ASSERT_EQ(sender.stats().sent, 1u);
+    }
+    const size_t before = mock_get("/messages").size();
+    EXPECT_GE(before, 1u);
+    EXPECT_LT(before, sent.size());
+
+    TelegramSender sender(options());
+    EXPECT_EQ(sender.pending(), sent.size() - before);
+    ASSERT_TRUE(sender.flush(10000));
+    EXPECT_EQ(texts(mock_get("/messages")), sent);
+    EXPECT_EQ(mock_get("/stats")["requests"].get<uint64_t>(), sent.size());
+}
+
+TEST_F(TelegramHttp, DropsOther4xxAndContinues) {
+    mock_get("/fail?status=403&count=1");
+    TelegramSender sender(options());
+    sender.enqueue("1", "forbidden");
+    sender.enqueue("1", "after");
+    ASSERT_TRUE(sender.flush(10000));
+
+    const TelegramSender::Stats st = sender.stats();
+    EXPECT_EQ(st.dropped, 1u);
+    EXPECT_EQ(st.retries, 0u);
+    EXPECT_EQ(st.sent, 1u);
+    EXPECT_EQ(mock_get("/stats")["requests"].get<uint64_t>(), 2u);
+    EXPECT_EQ(texts(mock_get("/messages")), (std::vector<std::string>{ "after" }));
+}
+
+TEST_F(TelegramFlaky, DeliversEveryMessageOnceInOrder) {
+    TelegramSender::Options opt = options();
+    opt.min_interval_ms = 200;
+    opt.max_attempts = 10;
+    TelegramSender sender(opt);
+    std::vector<std::string> sent;
+    for (int i = 0; i < 8; ++i) {
+        sent.push_back("flaky" + std::to_string(i));
+        sender.enqueue(i % 3 == 0 ? "2" : "1", sent.back());
+    }
+    const auto t0 = Clock::now();
+    ASSERT_TRUE(sender.flush(60000));
+    const auto elapsed = Clock::now() - t0;
+
+    const json messages = mock_get("/messages");
+    EXPECT_EQ(texts(messages), sent);
+    EXPECT_GE(min_gap_per_chat(messages), 0.19);
+
+    const TelegramSender::Stats st = sender.stats();
+    const json s = mock_get("/stats");
+    EXPECT_GT(st.retries, 0u);
+    EXPECT_EQ(st.sent, sent.size());
+    EXPECT_EQ(st.dropped, 0u);
+    EXPECT_EQ(s["failures"].get<uint64_t>(), st.retries);
+    EXPECT_EQ(s["requests"].get<uint64_t>(), st.sent + st.retries);
+    // 429 마다 retry_after 1초를 기다렸어야 함
+    EXPECT_GE(elapsed, std::chrono::seconds(by_status(s, "429")));
+}
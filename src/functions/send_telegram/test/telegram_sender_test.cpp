@@ -0,0 +1,210 @@
+#include "delivery_queue.hpp"
+#include "telegram_sender.hpp"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// ---- 텔레그램 전송기: 메시지 나누기 + 영구 대기열 ----
+
+namespace {
+
+// UTF-8 을 UTF-16 단위로 셈. 잘린 시퀀스가 있으면 -1
+long utf16_units(const std::string& s) {
+    long units = 0;
+    for (size_t i = 0; i < s.size();) {
+        const unsigned char c = (unsigned char)s[i];
+        const size_t len = c < 0x80 ? 1 : (c >> 5) == 0x6 ? 2 : (c >> 4) == 0xE ? 3 : (c >> 3) == 0x1E ? 4 : 0;
+        if (!len || i + len > s.size()) return -1;
+        for (size_t k = 1; k < len; ++k)
+            if (((unsigned char)s[i + k] >> 6) != 0x2) return -1;
+        units += len == 4 ? 2 : 1;
+        i += len;
+    }
+    return units;
+}
+
+// 나눈 조각이 모두 제한 안이고 글자를 가르지 않았는지, 이어 붙이면 (버린 구분자 빼고) 원문인지
+void expect_valid_split(const std::string& text, size_t limit) {
+    const auto parts = split_telegram_text(text, limit);
+    std::string joined;
+    for (const auto& p : parts) {
+        const long u = utf16_units(p);
+        EXPECT_GE(u, 1) << "broken UTF-8 or empty chunk";
+        EXPECT_LE(u, (long)std::max<size_t>(limit, 2));
+        joined += p;
+    }
+    std::string stripped;
+    for (char c : text) if (c != ' ' && c != '\n') stripped += c;
+    std::string joined_stripped;
+    for (char c : joined) if (c != ' ' && c != '\n') joined_stripped += c;
+    EXPECT_EQ(joined_stripped, stripped);
+}
+
+const std::string kHangul = "\xEA\xB0\x80";        // 가 (3바이트, UTF-16 1단위)
+const std::string kEmoji  = "\xF0\x9F\x98\x80";    // 😀 (4바이트, UTF-16 2단위)
+
+class QueueFile : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path_ = fs::temp_directory_path() / "epub2vocab_telegram_queue_test.log";
+        fs::remove(path_);
+    }
+    void TearDown() override {
+        std::error_code ec;
+        fs::remove(path_, ec);
+        fs::remove(path_.string() + ".tmp", ec);
+    }
+    void truncate_by(uintmax_t n) { fs::resize_file(path_, fs::file_size(path_) - n); }
+
+    fs::path path_;
+};
+
+} // namespace
+
+TEST(SplitTelegramText, ShortTextIsOneChunk) {
+    EXPECT_EQ(split_telegram_text("hello world", 4096), (std::vector<std::string>{ "hello world" }));
+    EXPECT_TRUE(split_telegram_text("", 10).empty());
+}
+
+TEST(SplitTelegramText, NewlinePreferredOverSpace) {
+    // 제한 안에 공백이 줄바꿈보다 뒤에 있어도 (절반 이후라면) 줄바꿈에서 자른다
+    const auto parts = split_telegram_text("aaaaaa\nbbb ccc dddd", 12);
+    ASSERT_GE(parts.size(), 2u);
+    EXPECT_EQ(parts[0], "aaaaaa");
+    EXPECT_EQ(parts[1].substr(0, 3), "bbb");
+}
+
+TEST(SplitTelegramText, SpaceUsedWithoutNewline) {
+    const auto parts = split_telegram_text("alpha beta gamma delta", 12);
+    EXPECT_EQ(parts, (std::vector<std::string>{ "alpha beta", "gamma delta" }));
+}
+
+TEST(SplitTelegramText, EarlySeparatorIgnored) {
+    // 절반보다 앞의 공백에서 자르면 조각이 너무 많아지므로 글자 경계에서 자른다
+    const auto parts = split_telegram_text("a bcdefghijklmnop", 8);
+    EXPECT_EQ(parts[0], "a bcdefg");
+}
+
+TEST(SplitTelegramText, NeverSplitsUtf8Sequence) {
+    std::string text;
+    for (int i = 0; i < 50; ++i) text += (i % 3 == 0) ? kEmoji : (i % 3 == 1) ? kHangul : "x";
+    for (size_t limit : { 1u, 2u, 3u, 5u, 7u, 16u }) {
+        SCOPED_TRACE(limit);
+        expect_valid_split(text, limit);
+    }
+}
+
+TEST(SplitTelegramText, SurrogatePairsCountTwice) {
+    // 😀 는 UTF-16 2단위 → 제한 4 에 2개까지
+    const std::string four = kEmoji + kEmoji + kEmoji + kEmoji;
+    const auto parts = split_telegram_text(four, 4);
+    EXPECT_EQ(parts, (std::vector<std::string>{ kEmoji + kEmoji, kEmoji + kEmoji }));
+    // 한글은 1단위 → 제한 4 에 4개
+    EXPECT_EQ(split_telegram_text(kHangul + kHangul + kHangul + kHangul, 4).size(), 1u);
+}
+
+TEST(SplitTelegramText, AdvancesWhenFirstCodePointDoesNotFit) {
+    // 제한 1 에 2단위 글자: 그 글자 하나씩 (멈추지 않고)
+    const auto parts = split_telegram_text(kEmoji + "a" + kEmoji, 1);
+    EXPECT_EQ(parts, (std::vector<std::string>{ kEmoji, "a", kEmoji }));
+}
+
+TEST(SplitTelegramText, BlankChunksDropped) {
+    // 공백/줄바꿈만 남은 조각은 보내지 않는다 (자른 자리의 구분자 하나 말고는 그대로 둠)
+    const std::string text = "abc\n\n\n\n\n\n      \n\n\ndef";
+    const auto parts = split_telegram_text(text, 4);
+    for (const auto& p : parts) EXPECT_NE(p.find_first_not_of(" \n"), std::string::npos) << "'" << p << "'";
+    ASSERT_FALSE(parts.empty());
+    EXPECT_EQ(parts.front(), "abc");
+    expect_valid_split(text, 4);
+    EXPECT_TRUE(split_telegram_text("   \n\n  ", 3).empty());
+}
+
+TEST(SplitTelegramText, InvalidBytesPassThrough) {
+    // 잘못된 선두 바이트/잘린 시퀀스는 1바이트 글자로 취급 (멈추거나 범위를 넘지 않음)
+    const std::string text = std::string("ab\xFF\x80") + "\xE2\x80";
+    std::string joined;
+    for (const auto& p : split_telegram_text(text, 2)) joined += p;
+    EXPECT_EQ(joined, text);
+}
+
+TEST_F(QueueFile, ReplaysUnackedMessages) {
+    {
+        DeliveryQueue q(path_);
+        q.push("1", "first");
+        q.push("1", "second");
+        q.push("2", "third");
+        q.pop_front();                  // first 전송 완료
+    }
+    DeliveryQueue q(path_);
+    ASSERT_EQ(q.size(), 2u);
+    EXPECT_EQ(q.front()->text, "second");
+    q.pop_front();
+    EXPECT_EQ(q.front()->chat_id, "2");
+    EXPECT_EQ(q.front()->text, "third");
+
+    // 새 id 는 이전 실행의 id 와 겹치지 않는다
+    const uint64_t old_id = q.front()->id;
+    EXPECT_GT(q.push("1", "fourth"), old_id);
+}
+
+TEST_F(QueueFile, EmptyQueueTruncatesFile) {
+    {
+        DeliveryQueue q(path_);
+        q.push("1", "only");
+        q.pop_front();
+    }
+    EXPECT_EQ(fs::file_size(path_), 0u);
+    DeliveryQueue q(path_);
+    EXPECT_TRUE(q.empty());
+}
+
+TEST_F(QueueFile, TornPushIsDropped) {
+    {
+        DeliveryQueue q(path_);
+        q.push("1", "kept");
+        q.push("1", "torn message text");
+    }
+    truncate_by(5);                     // 마지막 push 의 payload 가 잘림
+    DeliveryQueue q(path_);
+    ASSERT_EQ(q.size(), 1u);
+    EXPECT_EQ(q.front()->text, "kept");
+}
+
+TEST_F(QueueFile, TornAckKeepsMessage) {
+    {
+        DeliveryQueue q(path_);
+        q.push("1", "a");
+        q.push("1", "b");
+        q.pop_front();                  // a 의 ack (헤더만 24바이트)
+    }
+    truncate_by(10);                    // ack 레코드가 잘림 → a 는 다시 보낸다
+    DeliveryQueue q(path_);
+    ASSERT_EQ(q.size(), 2u);
+    EXPECT_EQ(q.front()->text, "a");
+}
+
+TEST_F(QueueFile, CorruptPayloadStopsReplay) {
+    {
+        DeliveryQueue q(path_);
+        q.push("1", "good");
+        q.push("1", "flipped");
+        q.push("1", "after");
+    }
+    {
+        // 두 번째 레코드 payload 의 한 바이트를 바꾼다 (체크섬 불일치) → 그 뒤는 믿지 않음
+        std::fstream f(path_, std::ios::binary | std::ios::in | std::ios::out);
+        const std::streamoff second = 24 + 6 + 24;   // 헤더 + "1\0good" + 헤더
+        f.seekp(second + 3);
+        f.put('X');
+    }
+    DeliveryQueue q(path_);
+    ASSERT_EQ(q.size(), 1u);
+    EXPECT_EQ(q.front()->text, "good");
+}
@@ -0,0 +1,150 @@
+#include "tokenizer_simd.hpp"
+
+// x86-64 는 SSE2 가 기본이므로 별도 컴파일 플래그 없이 사용 (AVX2 는 함수 단위 target)
+#if defined(__x86_64__) || defined(_M_X64)
+  #define E2V_X86 1
+  #include <immintrin.h>
+  #ifdef _MSC_VER
+    #include <intrin.h>
+  #endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+  #define E2V_TARGET_AVX2 __attribute__((target("avx2")))
+  #define E2V_CTZ(x) __builtin_ctz(x)
+#else
+  #define E2V_TARGET_AVX2
+  static inline unsigned e2v_ctz(unsigned x) { unsigned long i; _BitScanForward(&i, x); return (unsigned)i; }
+  #define E2V_CTZ(x) e2v_ctz(x)
+#endif
+
+namespace {
+
+// ---- 스칼라 꼬리 처리 (블록보다 짧은 나머지) ----
+inline bool is_letter(unsigned char c) { return (unsigned char)((c | 0x20) - 'a') < 26; }
+inline bool is_lower(unsigned char c)  { return (unsigned char)(c - 'a') < 26; }
+inline bool is_space(unsigned char c)  { return c == ' ' || (unsigned char)(c - 9) < 5; }
+
+size_t letter_tail(const unsigned char* p, size_t n, bool& any_lower) {
+    size_t i = 0;
+    while (i < n && is_letter(p[i])) { any_lower |= is_lower(p[i]); ++i; }
+    return i;
+}
+size_t space_tail(const unsigned char* p, size_t n) {
+    size_t i = 0;
+    while (i < n && is_space(p[i])) ++i;
+    return i;
+}
+
+#ifdef E2V_X86
+
+// 부호 있는 8비트 비교로 범위 판정: x + (128 - lo) 가 lo..lo+len-1 을 -128..-128+len-1 로 보낸다
+//   알파벳: (c | 0x20) ∈ 'a'..'z'   소문자: c ∈ 'a'..'z'   공백: c == ' ' 또는 c ∈ 9..13
+
+// ---- SSE2 (16바이트) ----
+inline unsigned sse2_letter_mask(__m128i v, unsigned& lower) {
+    const __m128i lo   = _mm_add_epi8(v, _mm_set1_epi8((char)(128 - 'a')));
+    const __m128i fold = _mm_add_epi8(_mm_or_si128(v, _mm_set1_epi8(0x20)), _mm_set1_epi8((char)(128 - 'a')));
+    const __m128i lim  = _mm_set1_epi8((char)(-128 + 26));
+    lower = (unsigned)_mm_movemask_epi8(_mm_cmplt_epi8(lo, lim));
+    return (unsigned)_mm_movemask_epi8(_mm_cmplt_epi8(fold, lim));
+}
+inline unsigned sse2_space_mask(__m128i v) {
+    const __m128i ctl = _mm_cmplt_epi8(_mm_add_epi8(v, _mm_set1_epi8((char)(128 - 9))), _mm_set1_epi8((char)(-128 + 5)));
+    const __m128i sp  = _mm_cmpeq_epi8(v, _mm_set1_epi8(' '));
+    return (unsigned)_mm_movemask_epi8(_mm_or_si128(ctl, sp));
+}
+
+size_t sse2_letter_run(const unsigned char* p, size_t n, bool& any_lower) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        unsigned lower;
+        const unsigned m = sse2_letter_mask(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)), lower);
+        if (m != 0xFFFFu) {
+            const unsigned k = E2V_CTZ(~m);
+            any_lower |= (lower & ((1u << k) - 1)) != 0;
+            return i + k;
+        }
+        any_lower |= lower != 0;
+    }
+    return i + letter_tail(p + i, n - i, any_lower);
+}
+
+size_t sse2_space_run(const unsigned char* p, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const unsigned m = sse2_space_mask(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)));
+        if (m != 0xFFFFu) return i + E2V_CTZ(~m);
+    }
+    return i + space_tail(p + i, n - i);
+}
+
+// ---- AVX2 (32바이트) ----
+E2V_TARGET_AVX2
+size_t avx2_letter_run(const unsigned char* p, size_t n, bool& any_lower) {
+    const __m256i bias = _mm256_set1_epi8((char)(128 - 'a'));
+    const __m256i lim  = _mm256_set1_epi8((char)(-128 + 26));
+    const __m256i bit5 = _mm256_set1_epi8(0x20);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i v    = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        const __m256i lo   = _mm256_add_epi8(v, bias);
+        const __m256i fold = _mm256_add_epi8(_mm256_or_si256(v, bit5), bias);
+        const unsigned lower = (unsigned)_mm256_movemask_epi8(_mm256_cmpgt_epi8(lim, lo));
+        const unsigned m     = (unsigned)_mm256_movemask_epi8(_mm256_cmpgt_epi8(lim, fold));
+        if (m != 0xFFFFFFFFu) {
+            const unsigned k = E2V_CTZ(~m);
+            any_lower |= k && (lower & (0xFFFFFFFFu >> (32 - k))) != 0;
+            return i + k;
+        }
+        any_lower |= lower != 0;
+    }
+    return i + sse2_letter_run(p + i, n - i, any_lower);
+}
+
+E2V_TARGET_AVX2
+size_t avx2_space_run(const unsigned char* p, size_t n) {
+    const __m256i bias = _mm256_set1_epi8((char)(128 - 9));
+    const __m256i lim  = _mm256_set1_epi8((char)(-128 + 5));
+    const __m256i sp   = _mm256_set1_epi8(' ');
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i v   = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        const __m256i ctl = _mm256_cmpgt_epi8(lim, _mm256_add_epi8(v, bias));
+        const unsigned m  = (unsigned)_mm256_movemask_epi8(_mm256_or_si256(ctl, _mm256_cmpeq_epi8(v, sp)));
+        if (m != 0xFFFFFFFFu) return i + E2V_CTZ(~m);
+    }
+    return i + sse2_space_run(p + i, n - i);
+}
+
+bool cpu_has_avx2() {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#else
+    int r[4];
+    __cpuid(r, 0);
+    if (r[0] < 7) return false;
+    __cpuid(r, 1);
+    const bool osxsave = (r[2] & (1 << 27)) != 0, avx = (r[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) return false;
+    __cpuidex(r, 7, 0);
+    return (r[1] & (1 << 5)) != 0;
+#endif
+}
+
+const TokenKernel kSse2 = { "sse2", sse2_letter_run, sse2_space_run };
+const TokenKernel kAvx2 = { "avx2", avx2_letter_run, avx2_space_run };
+
+#endif // E2V_X86
+
+} // namespace
+
+const TokenKernel* best_token_kernel() {
+#ifdef E2V_X86
+    static const TokenKernel* k = cpu_has_avx2() ? &kAvx2 : &kSse2;
+    return k;
+#else
+    return nullptr;
+#endif
+}
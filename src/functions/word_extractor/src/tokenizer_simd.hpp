@@ -0,0 +1,17 @@
+#pragma once
+#include <cstddef>
+
+// 토크나이저 SIMD 보조 커널
+// 16/32바이트 블록을 한 번에 분류(알파벳/소문자/공백 마스크)해서 토큰 경계까지 건너뛴다.
+// 연결자·따옴표·문장부호 같은 나머지 바이트는 WordStream 의 바이트 단위 규칙이 그대로 처리한다.
+struct TokenKernel {
+    const char* name;
+    // 앞쪽 연속 ASCII 알파벳 바이트 수, any_lower = 그 구간에 소문자가 있었는지
+    size_t (*letter_run)(const unsigned char* p, size_t n, bool& any_lower);
+    // 앞쪽 연속 공백(isspace: ' ', \t \n \v \f \r) 바이트 수
+    size_t (*space_run)(const unsigned char* p, size_t n);
+};
+
+// CPU 가 지원하는 최선의 커널 (AVX2 > SSE2), 없으면 nullptr (스칼라 경로)
+// 최초 호출 시 한 번 판정
+const TokenKernel* best_token_kernel();
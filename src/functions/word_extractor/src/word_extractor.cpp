@@ -173,16 +173,24 @@
 // }
 
 
+
+#include "word_extractor.hpp"
+#include "wordlist_image.hpp"
+#include "tokenizer_simd.hpp"
+#include "image_loader.hpp"
+
 #include <cctype>
 #include <string>
 #include <vector>
-#include <unordered_set>
 #include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <functional>
 #include <chrono>
 #include <iomanip>
+#include <stdexcept>
+#include <atomic>
+#include <thread>
 
 
 #include <filesystem>
@@ -211,9 +219,10 @@ inline char ascii_to_lower(unsigned char c) {
     return char(c);
 }
 
-// words.txt / stopwords.txt 로더 (기존과 동일)
-static std::unordered_set<std::string> load_wordlist(const char* path) {
-    std::unordered_set<std::string> set;
+// words.txt / stopwords.txt 텍스트 로더 (이미지가 없거나 낡았을 때의 폴백)
+// 정규화된 단어 목록 반환 (중복/정렬은 WordList::from_words 에서 처리)
+static std::vector<std::string> load_wordlist(const char* path) {
+    std::vector<std::string> set;
     std::ifstream fin(path, std::ios::binary);
     if (!fin) return set;
     std::string line;
@@ -246,195 +255,499 @@ static std::unordered_set<std::string> load_wordlist(const char* path) {
             }
             out.push_back(ascii_to_lower(c));
         }
-        set.insert(std::move(out));
+        set.push_back(std::move(out));
     }
     return set;
 }
 
 
-static std::filesystem::path locate_file(const char* name) {
-    namespace fs = std::filesystem;
-    const fs::path cand1 = fs::current_path() / name; // CWD
-    if (fs::exists(cand1)) return cand1;
-    const fs::path cand2 = exe_dir() / name;          // exe 옆
-    if (fs::exists(cand2)) return cand2;
-    return {}; // 못 찾음
+// 텍스트를 파싱해 WordList 로 (이미지 저장/신선도 판정은 image_loader)
+static WordList parse_wordlist(const std::filesystem::path& txt) {
+    const std::string path_str = txt.string();
+    return WordList::from_words(load_wordlist(path_str.c_str()));
 }
 
-// ====== auto 로더: 경로 찾고 기존 load_wordlist 재사용 ======
-static std::unordered_set<std::string> load_wordlist_auto(const char* name) {
-    auto p = locate_file(name);
-    if (p.empty()) {
+// ====== auto 로더: 경로 찾고, 이미지가 txt 보다 새로우면 mmap, 아니면 txt 재파싱 + 이미지 재생성 ======
+static WordList load_wordlist_auto(const char* name) {
+    const std::string bin = image_path_for(name).string();
+    std::string source;
+    WordList wl = load_or_rebuild_image(name, bin.c_str(), parse_wordlist, WordList::open_image, &source);
+    if (source.empty()) {
         std::cerr << "[warn] cannot find " << name
                   << " (tried CWD and exe dir)\n";
         return {};
     }
-    // 찾은 경로 문자열을 기존 로더에 전달
-    const std::string path_str = p.string();
-    auto set = load_wordlist(path_str.c_str());
-    if (set.empty()) {
-        std::cerr << "[warn] loaded 0 entries from " << path_str
+
+    if (wl.empty()) {
+        std::cerr << "[warn] loaded 0 entries from " << source
                   << " (check encoding/contents)\n";
     } else {
-        std::cout << "[info] loaded " << set.size() << " entries from "
-                  << path_str << "\n";
+        std::cout << "[info] loaded " << wl.size() << " entries from "
+                  << source << "\n";
     }
-    return set;
+    return wl;
 }
 
-static const std::unordered_set<std::string>& DICT() {
+static const WordList& DICT() {
     static const auto dict = load_wordlist_auto("words.txt");
     return dict;
 }
-static const std::unordered_set<std::string>& STOP() {
+static const WordList& STOP() {
     static const auto stop = load_wordlist_auto("stopwords.txt");
     return stop;
 }
 
-// 본체: 입력 문자열을 한 번만 스캔하여 토큰화+정규화+필터
-// 반환: 사전/불용어/규칙 통과한 "고유한" 단어 집합
-static std::unordered_set<std::string> unique_words_fast(const std::string& text, const ProgressFn& on_progress = {}) {
-    const size_t n = text.size();
-    const auto& dict = DICT();
-    const auto& stop = STOP();
+// ====== Lexicon: 사전 + 불용어를 한 번의 탐사로 ======
+// 사전 항목 id 별 플래그 바이트. 사전에 없는 불용어는 어차피 통과하지 못하므로 무시한다.
+enum : uint8_t { kLexWord = 1, kLexStop = 2 };
 
-    std::unordered_set<std::string> out;
-    out.reserve(4096); // 대략적인 초기 버킷 (필요시 조정)
+struct Lexicon {
+    const WordList* dict = nullptr;
+    std::vector<uint8_t> flags;
+
+    // 0 이면 사전에 없음. 있으면 id 를 채우고 플래그 반환
+    uint8_t probe(std::string_view w, uint32_t hv, uint32_t& id) const {
+        int32_t i = dict->find(w, hv);
+        if (i < 0) return 0;
+        id = (uint32_t)i;
+        return flags[id];
+    }
+};
 
-    std::string cur; cur.reserve(32);
+static const Lexicon& LEX() {
+    static const Lexicon lex = []{
+        Lexicon l;
+        l.dict = &DICT();
+        l.flags.assign(DICT().size(), kLexWord);
+        const WordList& stop = STOP();
+        for (uint32_t s = 0; s < stop.size(); ++s) {
+            int32_t id = DICT().find(stop.word(s));
+            if (id >= 0) l.flags[id] |= kLexStop;
+        }
+        return l;
+    }();
+    return lex;
+}
 
-    bool in_token = false;
-    bool at_sentence_start = true;
-    // 고유명사/대문자 판정용 플래그(문자 저장 대신 플래그만)
-    bool first_is_upper = false;
-    bool seen_lower = false;
-    bool all_caps = true;
-    bool token_started_at_sentence_start = false;
+size_t dictionary_size() { return DICT().size(); }
+std::string_view dictionary_word(uint32_t id) { return DICT().word(id); }
+std::string_view dictionary_image() { return DICT().image(); }
+std::string_view stopword_image() { return STOP().image(); }
+
+int compile_dictionary_images() {
+    int built = 0;
+    for (const char* name : { "words.txt", "stopwords.txt" }) {
+        auto p = locate_data_file(name);
+        if (p.empty()) {
+            std::cerr << "[warn] cannot find " << name << " (tried CWD and exe dir)\n";
+            continue;
+        }
+        WordList wl = rebuild_image(p, parse_wordlist);
+        std::cout << "[info] compiled " << wl.size() << " entries → "
+                  << image_path_for(p).string() << "\n";
+        ++built;
+    }
+    return built;
+}
 
-    size_t next_report = n / 50;
-    if (next_report == 0) next_report = 1024 * 64; // 최소 64KB 단위
+// ====== WordStream: 증분 토크나이저 ======
+// 기존 unique_words_fast 루프를 상태 객체로 옮긴 것. 규칙은 동일하다.
+static std::atomic<bool> g_simd{true};
 
-    for (size_t i=0; i<n; ++i) {
-        unsigned char c = (unsigned char)text[i];
+void set_tokenizer_simd(bool enabled) { g_simd = enabled; }
 
-        // std::cout << c;
+static std::function<void(uint32_t)> g_new_word_hook;
 
-        // Ctrl+Z 무시
-        if (c == 0x1A) continue;
+void set_new_word_hook(std::function<void(uint32_t id)> hook) { g_new_word_hook = std::move(hook); }
 
-        auto commit_token = [&](){
-            if (!in_token) return;
+const char* tokenizer_kernel_name() {
+    const TokenKernel* k = g_simd ? best_token_kernel() : nullptr;
+    return k ? k->name : "scalar";
+}
 
-            // 1) 한 글자 제외
-            if (cur.size() <= 1) { cur.clear(); in_token=false; return; }
+WordStream::WordStream()
+    : WordStream(g_simd.load())
+{}
 
-            // 2) TitleCase(문장 중간) 제외 + ALL-CAPS 제외
-            bool looks_titlecase = first_is_upper && seen_lower;
-            bool is_proper_like  = looks_titlecase && !token_started_at_sentence_start;
+WordStream::WordStream(bool use_simd)
+    : lex_(&LEX()), kernel_(use_simd ? best_token_kernel() : nullptr), on_new_word_(g_new_word_hook)
+{
+    slot_.assign(lex_->flags.size(), 0);
+    stats_.reserve(4096); // 대략적인 초기 크기 (필요시 조정)
+    cur_.reserve(64);
+}
 
-            if (!is_proper_like && !all_caps) {
-                // 3) 사전/스톱워드 필터
-                if (!cur.empty() && dict.find(cur)!=dict.end() && stop.find(cur)==stop.end()) {
-                    out.insert(cur);
-                }
+void WordStream::commit_token() {
+    if (!in_token_) return;
+    ++tokens_;
+
+    // 1) 한 글자 제외
+    if (cur_.size() <= 1) { cur_.clear(); in_token_=false; return; }
+
+    // 2) TitleCase(문장 중간) 제외 + ALL-CAPS 제외
+    bool looks_titlecase = first_is_upper_ && seen_lower_;
+    bool is_proper_like  = looks_titlecase && !token_started_at_sentence_start_;
+
+    if (!is_proper_like && !all_caps_) {
+        // 3) 사전/스톱워드 필터: 미리 누적한 해시로 한 번만 탐사, 중복은 id 로 판정
+        uint32_t id;
+        if (lex_->probe(cur_, hash_, id) == kLexWord) {
+            uint32_t& slot = slot_[id];
+            if (!slot) {
+                slot = stats_.add(id, tok_off_, tok_chapter_);
+                if (on_new_word_) on_new_word_(id);
             }
-            cur.clear();
-            in_token = false;
-        };
-
-        // --- 알파벳 ---
-        if (ascii_is_alpha(c)) {
-            const bool is_upper = (c >= 'A' && c <= 'Z');
-            const bool is_lower = (c >= 'a' && c <= 'z');
-            char lower = ascii_to_lower(c);
-
-            if (!in_token) {
-                in_token = true;
-                token_started_at_sentence_start = at_sentence_start;
-
-                // 첫 글자 특성 기록
-                first_is_upper = is_upper;
-                seen_lower     = is_lower;   // 첫 글자가 소문자라면 곧바로 true
-                all_caps       = is_upper;   // 첫 글자가 대문자면 일단 true로 시작
-            } else {
-                // 진행 중 소문자를 하나라도 보면 ALL-CAPS 해제
-                if (is_lower) {
-                    seen_lower = true;
-                    all_caps   = false;
-                }
-                // 대문자는 all_caps에 영향 없음(유지)
+            const uint32_t k = slot - 1;
+            ++stats_.counts[k];
+            if (stats_.last_chapter[k] != tok_chapter_) {   // 챕터는 순서대로 오므로 마지막 것만 비교
+                stats_.last_chapter[k] = tok_chapter_;
+                ++stats_.chapters[k];
             }
-
-            cur.push_back(lower);
-            at_sentence_start = false;
-            continue;
         }
-        // --- 내부 연결자: ' 또는 - (정규화: 그대로 저장) ---
-        // 바로 뒤가 알파벳이면 단어 내부로 포함
-        if ((c=='\'' || c=='-') && in_token && i+1<n && ascii_is_alpha((unsigned char)text[i+1])) {
-            cur.push_back((char)c);
-            continue;
+    }
+    cur_.clear();
+    in_token_ = false;
+}
+
+// 바이트 하나(p[i]) 처리 = 기존 스캔 루프 본문. 반환: 다음 위치
+// final=false 이고 청크 끝이라 lookahead 가 모자라면 kHold (상태는 바꾸지 않음)
+inline size_t WordStream::step(const unsigned char* p, size_t n, size_t i, bool final) {
+    unsigned char c = p[i];
+
+    // Ctrl+Z 무시
+    if (c == 0x1A) return i + 1;
+
+    // --- 알파벳 ---
+    if (ascii_is_alpha(c)) {
+        const bool is_upper = (c >= 'A' && c <= 'Z');
+        const bool is_lower = (c >= 'a' && c <= 'z');
+
+        if (!in_token_) {
+            in_token_ = true;
+            token_started_at_sentence_start_ = at_sentence_start_;
+
+            // 첫 글자 특성 기록
+            first_is_upper_ = is_upper;
+            seen_lower_     = is_lower;   // 첫 글자가 소문자라면 곧바로 true
+            all_caps_       = is_upper;   // 첫 글자가 대문자면 일단 true로 시작
+            hash_           = WordList::kHashSeed;
+            tok_off_        = base_ + i;
+            tok_chapter_    = chapter_;
+        } else if (is_lower) {
+            // 진행 중 소문자를 하나라도 보면 ALL-CAPS 해제
+            seen_lower_ = true;
+            all_caps_   = false;
         }
 
-        // --- UTF-8 ’ (E2 80 99) → ' ---
-        if (i+2<n && c==0xE2 &&
-            (unsigned char)text[i+1]==0x80 &&
-            (unsigned char)text[i+2]==0x99)
-        {
-            if (in_token && i+3<n && ascii_is_alpha((unsigned char)text[i+3])) {
-                cur.push_back('\'');
-                i += 2;
-                continue;
-            }
+        const char lower = ascii_to_lower(c);
+        cur_.push_back(lower);
+        hash_ = WordList::hash_step(hash_, (unsigned char)lower);
+        at_sentence_start_ = false;
+        return i + 1;
+    }
+
+    // 토큰 내부의 연결자 후보는 뒤 바이트를 봐야 판정 가능 → 청크 끝이면 다음 청크까지 보류
+    if (in_token_ && !final) {
+        size_t need = 0;
+        if      (c=='\'' || c=='-' || c==0x92) need = 1;
+        else if (c==0xA1)                     need = 2;
+        else if (c==0xE2)                     need = 3;
+        if (need && i + need >= n) return kHold;
+    }
+
+    // --- 내부 연결자: ' 또는 - (정규화: 그대로 저장) ---
+    // 바로 뒤가 알파벳이면 단어 내부로 포함
+    if ((c=='\'' || c=='-') && in_token_ && i+1<n && ascii_is_alpha(p[i+1])) {
+        cur_.push_back((char)c);
+        hash_ = WordList::hash_step(hash_, c);
+        return i + 1;
+    }
+
+    // --- UTF-8 ’ (E2 80 99) → ' ---
+    if (i+2<n && c==0xE2 && p[i+1]==0x80 && p[i+2]==0x99) {
+        if (in_token_ && i+3<n && ascii_is_alpha(p[i+3])) {
+            cur_.push_back('\'');
+            hash_ = WordList::hash_step(hash_, '\'');
+            return i + 3;
         }
-        // CP1252 ’
-        if (c==0x92) {
-            if (in_token && i+1<n && ascii_is_alpha((unsigned char)text[i+1])) {
-                cur.push_back('\'');
-                continue;
-            }
+    }
+    // CP1252 ’
+    if (c==0x92) {
+        if (in_token_ && i+1<n && ascii_is_alpha(p[i+1])) {
+            cur_.push_back('\'');
+            hash_ = WordList::hash_step(hash_, '\'');
+            return i + 1;
         }
-        // CP949 ‘/’
-        if (i+1<n && c==0xA1) {
-            unsigned char c2=(unsigned char)text[i+1];
-            if ((c2==0xAE || c2==0xAF) && in_token && i+2<n && ascii_is_alpha((unsigned char)text[i+2])) {
-                cur.push_back('\'');
-                i += 1;
-                continue;
-            }
+    }
+    // CP949 ‘/’
+    if (i+1<n && c==0xA1) {
+        unsigned char c2=p[i+1];
+        if ((c2==0xAE || c2==0xAF) && in_token_ && i+2<n && ascii_is_alpha(p[i+2])) {
+            cur_.push_back('\'');
+            hash_ = WordList::hash_step(hash_, '\'');
+            return i + 2;
         }
+    }
 
-        // 구분자 → 토큰 종료
-        commit_token();
+    // 구분자 → 토큰 종료
+    commit_token();
 
-        // 문장 시작 판정 (.,!,?)
-        if (c=='.' || c=='!' || c=='?') at_sentence_start = true;
-        else if (!std::isspace(c))     at_sentence_start = false;
+    // 문장 시작 판정 (.,!,?)
+    if (c=='.' || c=='!' || c=='?') at_sentence_start_ = true;
+    else if (!std::isspace(c))     at_sentence_start_ = false;
+    return i + 1;
+}
+
+// 연속 알파벳 구간을 한 번에 토큰에 덧붙임 (토큰 진행 중일 때만)
+inline void WordStream::append_letters(const unsigned char* p, size_t r, bool any_lower) {
+    const size_t old = cur_.size();
+    cur_.resize(old + r);
+    char* d = &cur_[old];
+    uint32_t h = hash_;
+    for (size_t k = 0; k < r; ++k) {
+        const unsigned char lower = p[k] | 0x20;    // 알파벳만 들어오므로 OR 로 소문자화
+        d[k] = (char)lower;
+        h = WordList::hash_step(h, lower);
+    }
+    hash_ = h;
+    if (any_lower) {
+        seen_lower_ = true;
+        all_caps_   = false;
+    }
+    at_sentence_start_ = false;
+}
+
+// p[0..n) 를 스캔. final=false 이면 청크 끝에서 lookahead 가 모자란 위치에서 멈추고
+// 소비한 바이트 수를 반환한다 (남은 바이트는 최대 3개).
+size_t WordStream::scan(const unsigned char* p, size_t n, bool final) {
+    return kernel_ ? scan_blocks(p, n, final) : scan_bytes(p, n, final);
+}
+
+// 스칼라 경로: 바이트 하나씩
+size_t WordStream::scan_bytes(const unsigned char* p, size_t n, bool final) {
+    for (size_t i = 0; i < n; ) {
+        const size_t j = step(p, n, i, final);
+        if (j == kHold) return i;
+        i = j;
+    }
+    return n;
+}
 
-        if (on_progress && (i % next_report == 0)) {
-            on_progress(i, n);
+// SIMD 경로: 토큰 안에서는 알파벳 구간, 토큰 밖에서는 공백 구간을 블록 단위로 건너뛰고
+// 경계 바이트만 step() 으로 처리 → 스칼라 경로와 같은 결과
+size_t WordStream::scan_blocks(const unsigned char* p, size_t n, bool final) {
+    const TokenKernel& k = *kernel_;
+    for (size_t i = 0; i < n; ) {
+        if (in_token_) {
+            bool any_lower = false;
+            const size_t r = k.letter_run(p + i, n - i, any_lower);
+            if (r) { append_letters(p + i, r, any_lower); i += r; }
+        } else {
+            i += k.space_run(p + i, n - i);     // 토큰 밖 공백은 상태를 바꾸지 않음
         }
+        if (i >= n) break;
 
+        const size_t j = step(p, n, i, final);
+        if (j == kHold) return i;
+        i = j;
     }
+    return n;
+}
+
+void WordStream::feed(const char* data, size_t n) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+    const uint64_t start = fed_;
+    fed_ += n;
+
+    // 이전 청크에서 보류한 꼬리 바이트가 있으면 새 청크 앞부분과 이어서 먼저 처리
+    if (!pending_.empty()) {
+        const size_t held = pending_.size();
+        const size_t take = std::min<size_t>(n, 4);   // lookahead 최대 3바이트면 충분
+        std::string tmp = pending_;
+        tmp.append(data, take);
+        base_ = start - held;
+        size_t used = scan(reinterpret_cast<const unsigned char*>(tmp.data()), tmp.size(), false);
+        if (used < held) {              // 새 청크가 4바이트 미만이라 아직도 판정 불가
+            pending_ = tmp.substr(used);
+            return;
+        }
+        pending_.clear();
+        p += used - held;
+        n -= used - held;
+    }
+
+    base_ = fed_ - n;
+    size_t used = scan(p, n, false);
+    if (used < n) pending_.assign(reinterpret_cast<const char*>(p + used), n - used);
+}
 
+const WordStats& WordStream::finish() {
+    if (!pending_.empty()) {
+        base_ = fed_ - pending_.size();
+        scan(reinterpret_cast<const unsigned char*>(pending_.data()), pending_.size(), true);
+        pending_.clear();
+    }
     // 마지막 토큰 flush
-    if (in_token) {
-        // commit_token() inline 복붙 (성능 미세 이득)
-        if (cur.size() > 1) {
-            bool looks_titlecase = first_is_upper && seen_lower;
-            bool is_proper_like  = looks_titlecase && !token_started_at_sentence_start;
-            if (!is_proper_like && !all_caps) {
-                if (dict.find(cur)!=dict.end() && STOP().find(cur)==STOP().end())
-                    out.insert(cur);
+    commit_token();
+    return stats_;
+}
+
+std::vector<std::string> WordStream::words() const {
+    return sorted_words(stats_);
+}
+
+// ====== WordStats ======
+uint32_t WordStats::add(uint32_t id, uint64_t offset, uint32_t chapter) {
+    ids.push_back(id);
+    counts.push_back(0);
+    first_offset.push_back(offset);
+    first_chapter.push_back(chapter);
+    chapters.push_back(1);
+    last_chapter.push_back(chapter);
+    return (uint32_t)ids.size();
+}
+
+void WordStats::reserve(size_t n) {
+    ids.reserve(n); counts.reserve(n); first_offset.reserve(n); first_chapter.reserve(n);
+    chapters.reserve(n); last_chapter.reserve(n);
+}
+
+std::vector<std::string> sorted_words(const WordStats& stats) {
+    std::vector<uint32_t> sorted = stats.ids;
+    std::sort(sorted.begin(), sorted.end());   // 사전 id 순 = 사전식 순
+    std::vector<std::string> v; v.reserve(sorted.size());
+    for (uint32_t id : sorted) v.emplace_back(DICT().word(id));
+    return v;
+}
+
+// text[a, b) 를 ws 에 넣으면서 챕터 경계(chapters 의 오프셋)에서 begin_chapter 호출
+// on_progress 가 있으면 64KB 이상 단위로 보고
+static void feed_range(WordStream& ws, const std::string& text, size_t a, size_t b,
+                       const ChapterMarks* chapters, const ProgressFn& on_progress = {}) {
+    const size_t n = text.size();
+    size_t step = n / 50;
+    if (step < 1024 * 64) step = 1024 * 64; // 최소 64KB 단위
+
+    // a 이전에 시작한 마지막 챕터부터
+    size_t next_ch = 0;
+    if (chapters) {
+        while (next_ch < chapters->size() && (*chapters)[next_ch].first <= a) {
+            ws.begin_chapter((*chapters)[next_ch].second);
+            ++next_ch;
+        }
+    }
+
+    for (size_t off = a; off < b; ) {
+        size_t end = std::min(off + step, b);
+        if (chapters && next_ch < chapters->size()) {
+            if ((*chapters)[next_ch].first <= off) {
+                ws.begin_chapter((*chapters)[next_ch].second);
+                ++next_ch;
+                continue;
             }
+            end = std::min(end, (*chapters)[next_ch].first);
         }
+        ws.feed(text.data() + off, end - off);
+        off = end;
+        if (on_progress) on_progress(off, n);
     }
+}
+
+// 본체: 입력 문자열을 한 번만 스캔하여 토큰화+정규화+필터
+// 반환: 사전/불용어/규칙 통과한 "고유한" 단어들의 통계 (횟수, 첫 위치, 챕터)
+static WordStats unique_words_fast(const std::string& text, const ChapterMarks* chapters,
+                                   const ProgressFn& on_progress = {}, size_t* tokens = nullptr) {
+    const size_t n = text.size();
+    WordStream ws;
+    feed_range(ws, text, 0, n, chapters, on_progress);
+    ws.finish();
 
     // 마지막 진행률 100% 보장
     if (on_progress) on_progress(n, n);
+    if (tokens) *tokens = ws.tokens();
+    return std::move(ws.stats());
+}
+
+// ====== 병렬(샤드) 추출 ======
+// 공백 바이트는 항상 토큰을 끝내고, lookahead 가 공백을 넘어 성공하는 경우도 없으므로
+// 공백 위치에서 자른 샤드는 in_token=false 상태에서 시작한다.
+// 문장 시작 상태는 샤드 앞쪽에서 마지막으로 본 "의미 있는" 바이트(공백/0x1A 제외)로 정해진다:
+// . ! ? 이면 true, 그 외(글자 포함)면 false, 없으면(텍스트 시작) true.
+static bool sentence_start_before(const std::string& text, size_t pos) {
+    while (pos > 0) {
+        const unsigned char c = (unsigned char)text[--pos];
+        if (c == 0x1A || std::isspace(c)) continue;
+        return c=='.' || c=='!' || c=='?';
+    }
+    return true;
+}
+
+// 대략 n/threads 크기로 자르되, 경계는 목표 지점 이후 첫 공백 바이트
+static std::vector<size_t> shard_bounds(const std::string& text, unsigned threads) {
+    const size_t n = text.size();
+    std::vector<size_t> b{0};
+    for (unsigned t = 1; t < threads; ++t) {
+        size_t target = std::max(b.back() + 1, n * t / threads);
+        if (target >= n) break;
+        size_t cut = text.find_first_of(" \t\n\v\f\r", target);
+        if (cut == std::string::npos) break;
+        b.push_back(cut);
+    }
+    b.push_back(n);
+    return b;
+}
+
+// 샤드마다 스레드 로컬 WordStream 으로 토큰화 → 샤드 순서대로 병합. 순차 결과와 동일
+// (첫 위치/챕터는 처음 나온 샤드의 값, 횟수는 합, 챕터 수는 샤드 경계에 걸친 챕터를 한 번만 센 합)
+static WordStats unique_words_parallel(const std::string& text, unsigned threads,
+                                       const ChapterMarks* chapters, size_t* tokens = nullptr) {
+    const auto bounds = shard_bounds(text, threads);
+    const size_t shards = bounds.size() - 1;
+
+    std::vector<WordStats> parts(shards);
+    std::vector<size_t> counts(shards, 0);
+    std::vector<std::thread> pool;
+    pool.reserve(shards);
+    for (size_t s = 0; s < shards; ++s) {
+        pool.emplace_back([&, s] {
+            WordStream ws;
+            ws.set_start_offset(bounds[s]);
+            ws.set_sentence_start(sentence_start_before(text, bounds[s]));
+            feed_range(ws, text, bounds[s], bounds[s + 1], chapters);
+            ws.finish();
+            parts[s] = std::move(ws.stats());
+            counts[s] = ws.tokens();
+        });
+    }
+    for (auto& t : pool) t.join();
+
+    WordStats out;
+    std::vector<uint32_t> slot(dictionary_size(), 0);
+    size_t total = 0;
+    for (size_t s = 0; s < shards; ++s) {
+        const WordStats& ps = parts[s];
+        for (size_t k = 0; k < ps.size(); ++k) {
+            uint32_t& sl = slot[ps.ids[k]];
+            const bool fresh = !sl;
+            if (fresh) sl = out.add(ps.ids[k], ps.first_offset[k], ps.first_chapter[k]);
+            const uint32_t o = sl - 1;
+            out.counts[o] += ps.counts[k];
+            if (fresh) out.chapters[o] = ps.chapters[k];
+            else out.chapters[o] += ps.chapters[k] - (out.last_chapter[o] == ps.first_chapter[k] ? 1 : 0);
+            out.last_chapter[o] = ps.last_chapter[k];
+        }
+        total += counts[s];
+    }
+    if (tokens) *tokens = total;
     return out;
 }
 
+WordStats extract_word_stats(const std::string& text, unsigned threads, const ChapterMarks* chapters,
+                             size_t* tokens) {
+    if (threads <= 1) return unique_words_fast(text, chapters, {}, tokens);
+    return unique_words_parallel(text, threads, chapters, tokens);
+}
+
 static void print_step(const char* msg) {
     std::cout << "[*] " << msg << std::endl;
 }
@@ -449,22 +762,118 @@ struct StepTimer {
     }
 };
 
-int word_extractor_main(const std::string& input) {
-    // I/O 가속
-    std::ios::sync_with_stdio(false);
-    std::cin.tie(nullptr);
-
-    StepTimer total;
-
+static void load_dictionaries_step() {
     print_step("Loading dictionaries...");
     StepTimer t1;
     const auto& dict = DICT();
     const auto& stop = STOP();
+    LEX();
     std::cout << "    - words.txt: " << dict.size() << " entries\n";
     std::cout << "    - stopwords.txt: " << stop.size() << " entries\n";
     std::cout << "    (load: " << std::fixed << std::setprecision(1) << t1.elapsed_ms() << " ms)\n";
+}
+
+void preload_dictionaries() {
+    load_dictionaries_step();
+}
 
-    print_step("Extracting unique words (tokenize + filter)...");
+// 추출 시간 + 토큰당 ns (핫 루프 측정용)
+static void print_extract_time(double ms, size_t tokens) {
+    std::cout << "    (extract: " << std::fixed << std::setprecision(1) << ms << " ms, "
+              << tokens << " tokens, " << std::setprecision(2)
+              << (tokens ? ms * 1e6 / tokens : 0.0) << " ns/token)\n";
+}
+
+int write_vocab_file(const std::filesystem::path& out, std::vector<std::string> v) {
+    std::sort(v.begin(), v.end());
+
+    std::ofstream fout(out, std::ios::binary);
+    if (!fout) throw std::runtime_error("failed to create: " + out.string());
+    fout << "Unique filtered words (" << v.size() << ")\n";
+    for (const auto& s : v) { fout << s << '\n'; }
+    return (int)v.size();
+}
+
+int write_stats_file(const std::filesystem::path& out, const WordStats& stats) {
+    std::vector<uint32_t> order(stats.size());
+    for (uint32_t k = 0; k < order.size(); ++k) order[k] = k;
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b){ return stats.ids[a] < stats.ids[b]; });
+
+    std::ofstream fout(out, std::ios::binary);
+    if (!fout) throw std::runtime_error("failed to create: " + out.string());
+    fout << "# word\tcount\tfirst_offset\tspine\tchapters\n";
+    for (uint32_t k : order) {
+        fout << DICT().word(stats.ids[k]) << '\t' << stats.counts[k] << '\t'
+             << stats.first_offset[k] << '\t' << stats.first_chapter[k] << '\t' << stats.chapters[k] << '\n';
+    }
+    return (int)order.size();
+}
+
+static int write_vocab_step(const WordStats& stats) {
+    print_step("Sorting & writing output...");
+    StepTimer t3;
+
+    // 파일로 저장 (vocab.txt 형식은 그대로, 통계는 옆에 TSV 로)
+    int count = write_vocab_file(exe_dir() / "vocab.txt", sorted_words(stats));
+    write_stats_file(exe_dir() / "vocab_stats.tsv", stats);
+    std::cout << "    - written: vocab.txt (" << count << " words) + vocab_stats.tsv\n";
+    std::cout << "    (write: " << std::fixed << std::setprecision(1) << t3.elapsed_ms() << " ms)\n";
+    return count;
+}
+
+const char* stats_difference(const WordStats& a, const WordStats& b) {
+    if (a.ids != b.ids) return "ids";
+    if (a.counts != b.counts) return "counts";
+    if (a.first_offset != b.first_offset) return "first_offset";
+    if (a.first_chapter != b.first_chapter) return "first_chapter";
+    if (a.chapters != b.chapters) return "chapters";
+    if (a.last_chapter != b.last_chapter) return "last_chapter";
+    return nullptr;
+}
+
+bool verify_tokenizer_simd(const std::string& text, const ChapterMarks* chapters) {
+    print_step("Verifying SIMD tokenizer against scalar path...");
+    const TokenKernel* k = best_token_kernel();
+    if (!k) {
+        std::cout << "    - no SIMD kernel on this CPU (scalar only)\n";
+        return true;
+    }
+
+    auto run = [&](bool simd, WordStats& stats, double& ms) {
+        WordStream ws(simd);
+        StepTimer t;
+        feed_range(ws, text, 0, text.size(), chapters);
+        ws.finish();
+        ms = t.elapsed_ms();
+        stats = std::move(ws.stats());
+        return ws.tokens();
+    };
+    WordStats a, b;
+    double ms_scalar = 0, ms_simd = 0;
+    const size_t tokens_a = run(false, a, ms_scalar);
+    const size_t tokens_b = run(true, b, ms_simd);
+    const char* diff = tokens_a != tokens_b ? "tokens" : stats_difference(a, b);
+
+    std::cout << "    - scalar: " << a.size() << " words, " << tokens_a << " tokens ("
+              << std::fixed << std::setprecision(1) << ms_scalar << " ms)\n";
+    std::cout << "    - " << k->name << ":   " << b.size() << " words, " << tokens_b << " tokens ("
+              << std::fixed << std::setprecision(1) << ms_simd << " ms)\n";
+    if (diff) std::cout << "[✗] OUTPUT MISMATCH (" << diff << ")\n";
+    else      std::cout << "[✓] identical output\n";
+    return !diff;
+}
+
+int word_extractor_main(const std::string& input, unsigned threads, const ChapterMarks* chapters,
+                        WordStats* stats_out) {
+    // I/O 가속
+    std::ios::sync_with_stdio(false);
+    std::cin.tie(nullptr);
+
+    StepTimer total;
+
+    load_dictionaries_step();
+
+    std::cout << "[*] Extracting unique words (tokenize + filter, " << tokenizer_kernel_name() << ")...\n";
     StepTimer t2;
 
     // 진행률 출력 콜백
@@ -475,28 +884,51 @@ int word_extractor_main(const std::string& input) {
                   << pct << "% (" << processed << "/" << total << ")" << std::flush;
     };
 
-    auto set = unique_words_fast(input, on_progress);
-    std::cout << "\r    progress: 100.00% (" << input.size() << "/" << input.size() << ")          \n";
-    std::cout << "    (extract: " << std::fixed << std::setprecision(1) << t2.elapsed_ms() << " ms)\n";
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    // 작은 텍스트는 스레드 비용이 더 큼 → 샤드당 최소 1MB
+    threads = (unsigned)std::min<size_t>(threads, std::max<size_t>(1, input.size() >> 20));
 
-    print_step("Sorting & writing output...");
-    StepTimer t3;
-    std::vector<std::string> v; v.reserve(set.size());
-    for (const auto& s : set) v.push_back(s);
-    std::sort(v.begin(), v.end());
+    size_t tokens = 0;
+    WordStats stats;
+    if (threads > 1) {
+        stats = unique_words_parallel(input, threads, chapters, &tokens);
+        std::cout << "    - shards: " << threads << "\n";
+    } else {
+        stats = unique_words_fast(input, chapters, on_progress, &tokens);
+        std::cout << "\r    progress: 100.00% (" << input.size() << "/" << input.size() << ")          \n";
+    }
+    print_extract_time(t2.elapsed_ms(), tokens);
 
-    // 파일로 저장
-    namespace fs = std::filesystem;
-    fs::path out = exe_dir() / "vocab.txt";
-    std::ofstream fout(out, std::ios::binary);
-    fout << "Unique filtered words (" << v.size() << ")\n";
-    for (const auto& s : v) { fout << s << '\n'; }
-    fout.close();
-    std::cout << "    - written: vocab.txt (" << v.size() << " words)\n";
-    std::cout << "    (write: " << std::fixed << std::setprecision(1) << t3.elapsed_ms() << " ms)\n";
+    int count = write_vocab_step(stats);
+    if (stats_out) *stats_out = std::move(stats);
 
     std::cout << "[✓] Done. Total: " << std::fixed << std::setprecision(1)
               << total.elapsed_ms() << " ms\n";
 
-    return (int)v.size();
+    return count;
+}
+
+int word_extractor_stream_main(const std::function<void(WordStream&)>& produce, WordStats* stats_out) {
+    std::ios::sync_with_stdio(false);
+    std::cin.tie(nullptr);
+
+    StepTimer total;
+
+    load_dictionaries_step();
+
+    std::cout << "[*] Extracting unique words (streaming, " << tokenizer_kernel_name() << ")...\n";
+    StepTimer t2;
+    WordStream ws;
+    produce(ws);
+    ws.finish();
+    std::cout << "    - streamed: " << ws.bytes_fed() << " bytes\n";
+    print_extract_time(t2.elapsed_ms(), ws.tokens());
+
+    int count = write_vocab_step(ws.stats());
+    if (stats_out) *stats_out = std::move(ws.stats());
+
+    std::cout << "[✓] Done. Total: " << std::fixed << std::setprecision(1)
+              << total.elapsed_ms() << " ms\n";
+
+    return count;
 }
@@ -1,4 +1,149 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
-int word_extractor_main(const std::string& input);
\ No newline at end of file
+struct Lexicon;
+struct TokenKernel;
+
+// 단어별 통계 (열 지향, 같은 인덱스 k 가 한 단어). 추출 루프에서 바로 채움 → 추가 패스 없음
+struct WordStats {
+    std::vector<uint32_t> ids;            // 사전 항목 id (처음 등장 순서)
+    std::vector<uint32_t> counts;         // 등장 횟수 (필터를 통과한 등장만)
+    std::vector<uint64_t> first_offset;   // 첫 등장 바이트 오프셋 (입력 텍스트/스트림 기준)
+    std::vector<uint32_t> first_chapter;  // 첫 등장 spine 인덱스
+    std::vector<uint32_t> chapters;       // 등장한 서로 다른 spine 수 (챕터 분산)
+    std::vector<uint32_t> last_chapter;   // 마지막 등장 spine 인덱스 (chapters 갱신/샤드 병합용)
+
+    size_t size() const { return ids.size(); }
+    // 새 단어 추가 (횟수 0), 반환: 인덱스 + 1
+    uint32_t add(uint32_t id, uint64_t offset, uint32_t chapter);
+    void reserve(size_t n);
+};
+
+// 합쳐진 텍스트에서 spine 문서가 시작하는 위치: (텍스트 오프셋, spine 인덱스)
+using ChapterMarks = std::vector<std::pair<size_t, uint32_t>>;
+
+// 증분(스트리밍) 토크나이저
+// - feed() 로 텍스트를 청크 단위로 흘려 넣으면 unique_words_fast 와 같은 규칙으로 단어를 모은다
+// - in_token / at_sentence_start 등 토큰 상태는 청크 경계를 넘어 유지된다
+// - 청크 끝에서 판정이 보류된 바이트(최대 3바이트)만 내부에 보관 → 전체 텍스트 버퍼 없음
+class WordStream {
+public:
+    WordStream();                        // 커널은 set_tokenizer_simd() 설정을 따름
+    explicit WordStream(bool use_simd);  // false = 스칼라 경로 강제
+
+    void feed(const char* data, size_t n);
+    void feed(const std::string& s) { feed(s.data(), s.size()); }
+
+    // 이후 들어오는 텍스트의 spine 인덱스 (스트리밍: 챕터마다 호출)
+    void begin_chapter(uint32_t spine_index) { chapter_ = spine_index; }
+
+    // 보류 바이트 + 마지막 토큰 flush 후 결과 반환 (이후 feed 금지)
+    // 결과 = 통과한 단어별 통계 (처음 등장 순서, 중복 없음)
+    const WordStats& finish();
+
+    const WordStats& stats() const { return stats_; }
+    WordStats& stats() { return stats_; }
+    // 통과한 단어들 (사전 id 순 = 사전식 정렬 순)
+    std::vector<std::string> words() const;
+
+    // 샤드 시작 시 상태 지정 (기본: 오프셋 0, 문장 시작 true). feed 전에만 호출
+    void set_sentence_start(bool at_start) { at_sentence_start_ = at_start; }
+    void set_start_offset(uint64_t offset) { fed_ = offset; }
+
+    uint64_t bytes_fed() const { return fed_; }
+    size_t tokens() const { return tokens_; }
+
+private:
+    static constexpr size_t kHold = ~size_t(0);
+
+    size_t scan(const unsigned char* p, size_t n, bool final);
+    size_t scan_bytes(const unsigned char* p, size_t n, bool final);
+    size_t scan_blocks(const unsigned char* p, size_t n, bool final);
+    size_t step(const unsigned char* p, size_t n, size_t i, bool final);
+    void append_letters(const unsigned char* p, size_t r, bool any_lower);
+    void commit_token();
+
+    const Lexicon* lex_;
+    const TokenKernel* kernel_;    // nullptr = 스칼라
+    std::function<void(uint32_t)> on_new_word_;   // set_new_word_hook 복사본 (없으면 비어 있음)
+    std::vector<uint32_t> slot_;   // 사전 id → stats_ 인덱스 + 1 (0 = 아직 없음, 문자열 복사 대신)
+    WordStats stats_;
+
+    std::string cur_;              // 재사용 버퍼 (clear 해도 capacity 유지)
+    uint32_t hash_ = 0;            // cur_ 의 FNV-1a 를 글자마다 누적
+    std::string pending_;
+    uint64_t fed_ = 0;             // 지금까지 들어온 바이트 (= 스트림 위치)
+    uint64_t base_ = 0;            // 지금 스캔 중인 버퍼 p[0] 의 스트림 위치
+    uint64_t tok_off_ = 0;         // 현재 토큰 시작 위치
+    uint32_t chapter_ = 0;
+    uint32_t tok_chapter_ = 0;
+    size_t tokens_ = 0;
+
+    bool in_token_ = false;
+    bool at_sentence_start_ = true;
+    // 고유명사/대문자 판정용 플래그(문자 저장 대신 플래그만)
+    bool first_is_upper_ = false;
+    bool seen_lower_ = false;
+    bool all_caps_ = true;
+    bool token_started_at_sentence_start_ = false;
+};
+
+// 새 사전 단어가 처음 나올 때마다 호출할 콜백 (사전 id). 이후 만들어지는 WordStream 에 적용
+// 병렬 샤드에서는 여러 스레드가 동시에, 같은 id 로 여러 번 부를 수 있다 → 콜백이 스레드 안전해야 함
+void set_new_word_hook(std::function<void(uint32_t id)> hook);
+
+// 토크나이저 SIMD 커널 사용 여부 (기본 on, CPU 가 지원하는 최선: avx2 > sse2)
+void set_tokenizer_simd(bool enabled);
+const char* tokenizer_kernel_name();
+
+// 스칼라 경로와 SIMD 경로를 같은 텍스트에 돌려 결과(WordStats 전체 열 + 토큰 수)를 비교, 같으면 true
+// chapters 가 있으면 그 경계에서 begin_chapter 를 불러 first_chapter/chapters 열까지 비교
+bool verify_tokenizer_simd(const std::string& text, const ChapterMarks* chapters = nullptr);
+
+// 두 통계에서 처음 다른 열 이름 ("ids", "counts", ...), 모두 같으면 nullptr
+const char* stats_difference(const WordStats& a, const WordStats& b);
+
+// threads <= 1 이면 순차(unique_words_fast), 아니면 공백 경계 샤드 병렬 추출. 결과는 모든 열이 같아야 한다.
+// word_extractor_main 과 달리 샤드당 1MB 하한 없이 threads 그대로 (작은 입력으로도 샤드 경계를 검사할 수 있게)
+WordStats extract_word_stats(const std::string& text, unsigned threads = 1, const ChapterMarks* chapters = nullptr,
+                             size_t* tokens = nullptr);
+
+// threads > 1 이면 공백 경계로 샤드를 나눠 병렬 추출 (결과는 순차와 동일, 0=코어 수)
+// chapters 가 있으면 vocab_stats.tsv 의 spine/chapters 열을 채운다
+// stats_out 이 있으면 단어별 통계를 넘겨준다 (단어 선택 점수용, 파일을 다시 읽지 않게)
+int word_extractor_main(const std::string& input, unsigned threads = 1, const ChapterMarks* chapters = nullptr,
+                        WordStats* stats_out = nullptr);
+
+// 스트리밍 모드: produce(ws) 안에서 ws.feed() 로 텍스트를 넣는다 → vocab.txt 저장
+int word_extractor_stream_main(const std::function<void(WordStream&)>& produce, WordStats* stats_out = nullptr);
+
+// words.txt / stopwords.txt 를 미리 로드 (배치 모드에서 워커 시작 전에 한 번)
+void preload_dictionaries();
+
+// words.txt / stopwords.txt → words.bin / stopwords.bin 강제 재생성, 반환: 만든 이미지 수
+// (평소에는 .txt 가 이미지보다 새로우면 로드 시 자동 재생성)
+int compile_dictionary_images();
+
+// 로드된 words.txt 항목 수 / id → 단어 (배치 모드에서 id 로 합집합을 만들 때)
+size_t dictionary_size();
+std::string_view dictionary_word(uint32_t id);
+
+// 로드된 words / stopwords 이미지 원본 바이트 (결과 캐시가 사전이 바뀌었는지 지문을 만들 때)
+std::string_view dictionary_image();
+std::string_view stopword_image();
+
+// 통계 → 정렬된 단어 목록
+std::vector<std::string> sorted_words(const WordStats& stats);
+
+// 통계를 TSV(word, count, first_offset, spine, chapters; 단어순)로 저장, 단어 수 반환
+int write_stats_file(const std::filesystem::path& out, const WordStats& stats);
+
+// 단어 목록을 정렬해 vocab 형식("Unique filtered words (N)" + 줄당 1단어)으로 저장, 단어 수 반환
+int write_vocab_file(const std::filesystem::path& out, std::vector<std::string> words);
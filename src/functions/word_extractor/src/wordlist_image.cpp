@@ -0,0 +1,141 @@
+#include "wordlist_image.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+const char     kMagic[8] = { 'E','2','V','W','L','S','T','\0' };
+const uint32_t kVersion  = 1;
+
+struct Header {
+    char     magic[8];
+    uint32_t version;
+    uint32_t count;
+    uint32_t slot_count;    // 2의 거듭제곱, 적재율 50% 이하
+    uint32_t pool_size;
+    uint32_t reserved;
+};
+static_assert(sizeof(Header) == 28, "unexpected Header padding");
+
+size_t align4(size_t n) { return (n + 3) & ~size_t(3); }
+
+} // namespace
+
+WordList WordList::from_words(std::vector<std::string> words) {
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+
+    const uint32_t count = (uint32_t)words.size();
+    uint32_t slot_count = 16;
+    while (slot_count < count * 2) slot_count <<= 1;
+
+    size_t pool_size = 0;
+    for (const auto& w : words) pool_size += w.size();
+
+    const size_t off_offsets = align4(sizeof(Header));
+    const size_t off_hashes  = off_offsets + sizeof(uint32_t) * (count + 1);
+    const size_t off_slots   = off_hashes  + sizeof(uint32_t) * count;
+    const size_t off_pool    = off_slots   + sizeof(uint32_t) * slot_count;
+
+    const size_t total = off_pool + pool_size;
+    std::vector<uint32_t> img((total + 3) / 4, 0);
+    char* base = reinterpret_cast<char*>(img.data());
+
+    Header h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = kVersion;
+    h.count = count;
+    h.slot_count = slot_count;
+    h.pool_size = (uint32_t)pool_size;
+    std::memcpy(base, &h, sizeof(h));
+
+    uint32_t* offsets = reinterpret_cast<uint32_t*>(base + off_offsets);
+    uint32_t* hashes  = reinterpret_cast<uint32_t*>(base + off_hashes);
+    uint32_t* slots   = reinterpret_cast<uint32_t*>(base + off_slots);
+    char*     pool    = base + off_pool;
+
+    uint32_t pos = 0;
+    for (uint32_t id = 0; id < count; ++id) {
+        const std::string& w = words[id];
+        offsets[id] = pos;
+        std::memcpy(pool + pos, w.data(), w.size());
+        pos += (uint32_t)w.size();
+
+        const uint32_t hv = hash(w);
+        hashes[id] = hv;
+        uint32_t i = hv & (slot_count - 1);
+        while (slots[i]) i = (i + 1) & (slot_count - 1);
+        slots[i] = id + 1;
+    }
+    offsets[count] = pos;
+
+    WordList wl;
+    wl.owned_ = std::move(img);
+    wl.bind(reinterpret_cast<const char*>(wl.owned_.data()), total);
+    return wl;
+}
+
+WordList WordList::open_image(const std::filesystem::path& path) {
+    WordList wl;
+    wl.map_ = MappedFile(path);
+    wl.bind(wl.map_.data(), wl.map_.size());
+    return wl;
+}
+
+WordList WordList::view(const char* base, size_t size) {
+    WordList wl;
+    wl.bind(base, size);
+    return wl;
+}
+
+void WordList::bind(const char* base, size_t size) {
+    Header h;
+    if (!base || size < sizeof(Header))
+        throw std::runtime_error("wordlist image: truncated header");
+    std::memcpy(&h, base, sizeof(h));
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0 || h.version != kVersion)
+        throw std::runtime_error("wordlist image: bad magic/version");
+    if (h.slot_count == 0 || (h.slot_count & (h.slot_count - 1)) != 0)
+        throw std::runtime_error("wordlist image: bad slot count");
+
+    const size_t off_offsets = align4(sizeof(Header));
+    const size_t off_hashes  = off_offsets + sizeof(uint32_t) * (size_t(h.count) + 1);
+    const size_t off_slots   = off_hashes  + sizeof(uint32_t) * size_t(h.count);
+    const size_t off_pool    = off_slots   + sizeof(uint32_t) * size_t(h.slot_count);
+    if (off_pool + h.pool_size != size)
+        throw std::runtime_error("wordlist image: size mismatch");
+
+    image_      = base;
+    image_size_ = size;
+    count_      = h.count;
+    mask_       = h.slot_count - 1;
+    offsets_    = reinterpret_cast<const uint32_t*>(base + off_offsets);
+    hashes_     = reinterpret_cast<const uint32_t*>(base + off_hashes);
+    slots_      = reinterpret_cast<const uint32_t*>(base + off_slots);
+    pool_       = base + off_pool;
+}
+
+int32_t WordList::find(std::string_view w, uint32_t hv) const {
+    if (!slots_) return -1;
+    for (uint32_t i = hv & mask_; slots_[i]; i = (i + 1) & mask_) {
+        const uint32_t id = slots_[i] - 1;
+        if (hashes_[id] == hv && word(id) == w) return (int32_t)id;
+    }
+    return -1;
+}
+
+void WordList::save_image(const std::filesystem::path& path) const {
+    if (!image_) throw std::runtime_error("wordlist image: nothing to save");
+    std::filesystem::path tmp = path;
+    tmp += ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) throw std::runtime_error("failed to create: " + tmp.string());
+        out.write(image_, (std::streamsize)image_size_);
+        if (!out) throw std::runtime_error("failed to write: " + tmp.string());
+    }
+    std::filesystem::rename(tmp, path);
+}
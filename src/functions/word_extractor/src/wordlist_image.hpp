@@ -0,0 +1,79 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mmap_file.hpp"
+
+// words.txt / stopwords.txt 의 바이너리 이미지 (mmap 으로 열면 파싱/할당 없음)
+//
+// 레이아웃 (리틀 엔디언, 모든 배열 4바이트 정렬)
+//   Header                     : magic, version, count, slot_count, pool_size
+//   uint32 offsets[count + 1]  : 정렬된 문자열 풀 안의 시작 위치 (id 순)
+//   uint32 hashes[count]       : 항목별 미리 계산한 FNV-1a 해시
+//   uint32 slots[slot_count]   : 오픈 어드레싱(선형 탐사) 테이블, 값 = id + 1 (0 = 빈 칸)
+//   char   pool[pool_size]     : 정렬된 단어들을 구분자 없이 이어 붙인 것
+class WordList {
+public:
+    WordList() = default;
+
+    // 정규화가 끝난 단어 목록으로 이미지를 메모리에 만든다 (중복 제거 + 정렬)
+    static WordList from_words(std::vector<std::string> words);
+    // 이미지 파일을 mmap 으로 연다. 형식이 맞지 않으면 예외(std::runtime_error)
+    static WordList open_image(const std::filesystem::path& path);
+    // 다른 파일 안에 박힌 이미지를 소유하지 않고 참조 (base 는 호출자가 살려 둬야 함)
+    static WordList view(const char* base, size_t size);
+
+    // 현재 이미지를 파일로 저장 (임시 파일 → rename)
+    void save_image(const std::filesystem::path& path) const;
+
+    bool contains(std::string_view w) const { return find(w) >= 0; }
+    // 항목 id (정렬 순서) 또는 -1
+    int32_t find(std::string_view w) const { return find(w, hash(w)); }
+    // 해시를 호출자가 미리 계산한 경우 (토크나이저가 글자를 붙이며 누적)
+    int32_t find(std::string_view w, uint32_t hv) const;
+    // 대량 조회용: 곧 find(…, hv) 할 슬롯을 미리 캐시로 당겨 둔다
+    void prefetch(uint32_t hv) const {
+#if defined(__GNUC__) || defined(__clang__)
+        if (slots_) __builtin_prefetch(slots_ + (hv & mask_));
+#else
+        (void)hv;
+#endif
+    }
+
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    std::string_view word(uint32_t id) const {
+        return std::string_view(pool_ + offsets_[id], offsets_[id + 1] - offsets_[id]);
+    }
+    bool mapped() const { return !map_.empty(); }
+    // 이미지 원본 바이트 (다른 이미지 파일에 통째로 넣을 때)
+    std::string_view image() const { return std::string_view(image_, image_size_); }
+
+    // FNV-1a. hash_step 으로 한 글자씩 누적해도 hash() 와 같은 값
+    static constexpr uint32_t kHashSeed = 2166136261u;
+    static uint32_t hash_step(uint32_t h, unsigned char c) { return (h ^ c) * 16777619u; }
+    static uint32_t hash(std::string_view w) {
+        uint32_t h = kHashSeed;
+        for (unsigned char c : w) h = hash_step(h, c);
+        return h;
+    }
+
+private:
+    void bind(const char* base, size_t size);
+
+    MappedFile  map_;        // mmap 백업 (open_image)
+    std::vector<uint32_t> owned_;   // 메모리 백업 (from_words, 이동해도 버퍼 주소 유지)
+    const char* image_ = nullptr;
+    size_t      image_size_ = 0;
+
+    uint32_t count_ = 0;
+    uint32_t mask_ = 0;
+    const uint32_t* offsets_ = nullptr;
+    const uint32_t* hashes_ = nullptr;
+    const uint32_t* slots_ = nullptr;
+    const char* pool_ = nullptr;
+};
@@ -0,0 +1,306 @@
+#include "word_extractor.hpp"
+#include "epub_reader.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// ---- 토크나이저: 스칼라 경로 vs SIMD 블록 경로 ----
+// 사전은 첫 WordStream 에서 CWD 의 words.txt 로 한 번만 로드된다 → 환경 SetUp 에서 임시 디렉토리에
+// 합성 단어 + sample.epub 에 나오는 단어로 words.txt / stopwords.txt 를 만들고 그 디렉토리로 이동
+
+namespace {
+
+std::string g_sample_text;
+ChapterMarks g_sample_chapters;
+
+const char* const kSyntheticWords[] = {
+    "don't", "it's", "well-known", "mother-in-law", "o'clock", "rock'n'roll", "alpha", "beta", "gamma",
+    "delta", "block", "edge", "quote", "joiner", "word", "words", "token", "tokens", "chapter", "sentence",
+};
+const char* const kStopwords[] = { "the", "and", "of", "to", "a", "in", "it's" };
+
+// 사전 항목 후보: 소문자 알파벳과 단어 안의 ' - (토크나이저가 만들 수 있는 모양)
+void collect_words(const std::string& text, std::set<std::string>& out) {
+    std::string cur;
+    auto flush = [&] {
+        while (!cur.empty() && (cur.back() == '\'' || cur.back() == '-')) cur.pop_back();
+        if (cur.size() > 1) out.insert(cur);
+        cur.clear();
+    };
+    for (unsigned char c : text) {
+        if ((c | 0x20) >= 'a' && (c | 0x20) <= 'z') cur.push_back(char(c | 0x20));
+        else if ((c == '\'' || c == '-') && !cur.empty()) cur.push_back(char(c));
+        else flush();
+    }
+    flush();
+}
+
+class DictionaryEnv : public ::testing::Environment {
+public:
+    void SetUp() override {
+        g_sample_text = extract_epub_text(EPUB2VOCAB_SAMPLE_EPUB, 1, &g_sample_chapters);
+
+        std::set<std::string> words(std::begin(kSyntheticWords), std::end(kSyntheticWords));
+        collect_words(g_sample_text, words);
+
+        dir_ = fs::temp_directory_path() / "epub2vocab_word_extractor_test";
+        fs::remove_all(dir_);
+        fs::create_directories(dir_);
+        {
+            std::ofstream out(dir_ / "words.txt", std::ios::binary);
+            for (const auto& w : words) out << w << '\n';
+        }
+        {
+            std::ofstream out(dir_ / "stopwords.txt", std::ios::binary);
+            for (const char* w : kStopwords) out << w << '\n';
+        }
+        fs::current_path(dir_);
+    }
+    void TearDown() override {
+        std::error_code ec;
+        fs::current_path(fs::temp_directory_path(), ec);
+        fs::remove_all(dir_, ec);
+    }
+
+private:
+    fs::path dir_;
+};
+
+const auto* const g_env = ::testing::AddGlobalTestEnvironment(new DictionaryEnv);
+
+struct Tokenized {
+    WordStats stats;
+    size_t tokens = 0;
+};
+
+// text 를 chunk 바이트씩 나눠 넣음 (0 = 한 번에). chapter_at 위치부터 spine 1
+Tokenized tokenize(const std::string& text, bool simd, size_t chunk = 0, size_t chapter_at = std::string::npos) {
+    WordStream ws(simd);
+    ws.begin_chapter(0);
+    if (!chunk) chunk = text.size() ? text.size() : 1;
+    for (size_t off = 0; off < text.size(); ) {
+        size_t end = std::min(off + chunk, text.size());
+        if (off < chapter_at && chapter_at < end) end = chapter_at;
+        if (off == chapter_at) ws.begin_chapter(1);
+        ws.feed(text.data() + off, end - off);
+        off = end;
+    }
+    ws.finish();
+    return { std::move(ws.stats()), ws.tokens() };
+}
+
+void expect_same(const std::string& text, size_t chunk = 0, size_t chapter_at = std::string::npos) {
+    const Tokenized scalar = tokenize(text, false, chunk, chapter_at);
+    const Tokenized simd = tokenize(text, true, chunk, chapter_at);
+    EXPECT_EQ(scalar.tokens, simd.tokens);
+    const char* diff = stats_difference(scalar.stats, simd.stats);
+    EXPECT_EQ(diff, nullptr) << "column " << (diff ? diff : "") << " differs, chunk=" << chunk;
+}
+
+// 단어 안/끝에 올 수 있는 연결자와 따옴표 (ASCII, UTF-8 ’ ‘ “ ” –, CP1252 ’, CP949 ’)
+const char* const kJoiners[] = {
+    "'", "-", "\xE2\x80\x99", "\xE2\x80\x98", "\xE2\x80\x9C", "\xE2\x80\x9D", "\xE2\x80\x93", "\x92", "\xA1\xAF",
+};
+
+// ---- 샤드 병렬 추출용 합성 텍스트 ----
+// 샤드 경계 규칙(shard_bounds): 목표 지점 n*t/threads 이후 첫 공백 바이트.
+// threads=2..8 의 모든 목표 지점이 아래 조각의 첫 단어(대문자 시작) 3번째 바이트에 오도록 덮어써서
+// 경계 바로 앞이 '.', '!', 멀티바이트 연결자, 0x1A 등이 되게 한다
+struct SeamPiece {
+    const char* text;
+    unsigned char before_cut;   // 경계(첫 공백) 바로 앞 바이트
+};
+
+const SeamPiece kSeamPieces[] = {
+    { "Gamma. Delta alpha. ", '.' },
+    { "Alpha Beta gamma ", 'a' },
+    { "Don\xE2\x80\x99t \xE2\x80\x9Cquote\xE2\x80\x9D word ", 't' },
+    { "Rock\xE2\x80\x99n\xE2\x80\x99roll\xE2\x80\x99 \xE2\x80\x98" "Alpha ", 0x99 },
+    { "Rock\x92n\x92roll\x92 o\x92" "clock ", 0x92 },
+    { "Well-Known! Beta ", '!' },
+    { "Edge.\xE2\x80\x9D Word block ", 0x9D },
+    { "Quote\xA1\xAF Token? Delta ", 0xAF },
+    { "Block\xC2\xA0" "Edge. Sentence ", '.' },
+    { "Alpha.\x1A Beta ", 0x1A },
+};
+
+bool is_ascii_space(unsigned char c) { return c == ' ' || (c >= '\t' && c <= '\r'); }
+
+// text 의 p 가 piece 첫 단어의 3번째 바이트가 되도록 덮어씀 (길이 유지). 앞 단어와 뒤에 잘린 UTF-8 꼬리는 공백으로
+void plant(std::string& text, size_t p, const std::string& piece) {
+    const size_t s = p - 3;
+    for (size_t w = s; w > 0 && !is_ascii_space((unsigned char)text[w - 1]); --w) text[w - 1] = ' ';
+    text.replace(s, piece.size(), piece);
+    for (size_t e = s + piece.size(); e < text.size() && ((unsigned char)text[e] & 0xC0) == 0x80; ++e) text[e] = ' ';
+}
+
+struct ShardText {
+    std::string text;
+    ChapterMarks chapters;
+    size_t seams = 0;
+};
+
+// sample.epub 본문을 min_size 이상 되도록 이어 붙이고 (spine 은 복사본마다 이어서 증가)
+// threads=2..8 의 샤드 목표 지점마다 조각을 심는다. 가운데 경계에는 챕터 경계도 하나 둔다
+ShardText make_shard_text(size_t min_size) {
+    ShardText st;
+    uint32_t spine = 0;
+    while (st.text.size() < min_size) {
+        const size_t base = st.text.size();
+        for (const auto& [off, idx] : g_sample_chapters) {
+            (void)idx;
+            st.chapters.emplace_back(base + off, spine);
+            spine += 2;
+        }
+        st.text += g_sample_text;
+        st.text += ' ';
+    }
+    const size_t n = st.text.size();
+    size_t k = 0;
+    std::set<size_t> targets;
+    for (size_t threads = 2; threads <= 8; ++threads)
+        for (size_t t = 1; t < threads; ++t) targets.insert(n * t / threads);
+    for (size_t p : targets) {
+        const SeamPiece& piece = kSeamPieces[k++ % std::size(kSeamPieces)];
+        plant(st.text, p, piece.text);
+        const size_t cut = st.text.find_first_of(" \t\n\v\f\r", p);
+        EXPECT_EQ((unsigned char)st.text[cut - 1], piece.before_cut) << "seam at " << p;
+        if (p == n / 2) {
+            // 경계 위치에서 시작하는 챕터 (앞 챕터와 다른 spine)
+            auto it = std::lower_bound(st.chapters.begin(), st.chapters.end(), std::make_pair(cut, 0u));
+            const uint32_t prev = it == st.chapters.begin() ? 0 : std::prev(it)->second;
+            st.chapters.insert(it, { cut, prev + 1 });
+        }
+    }
+    st.seams = targets.size();
+    return st;
+}
+
+} // namespace
+
+TEST(TokenizerSimd, SampleEpubMatchesScalar) {
+    ASSERT_FALSE(g_sample_text.empty());
+    EXPECT_TRUE(verify_tokenizer_simd(g_sample_text, &g_sample_chapters));
+}
+
+TEST(TokenizerSimd, SampleEpubChunkedMatchesScalar) {
+    // 스트리밍 모드처럼 잘게 나눠 넣어도 (보류 바이트가 청크 경계를 넘음) 같은 결과
+    for (size_t chunk : { 1u, 7u, 4093u })
+        expect_same(g_sample_text.substr(0, 200000), chunk);
+}
+
+TEST(TokenizerSimd, JoinersAtBlockEdges) {
+    // 연결자/따옴표가 16/32바이트 블록의 마지막 바이트 전후에 걸치도록 앞 단어 길이를 바꿔 가며
+    for (const char* j : kJoiners) {
+        for (size_t block : { 16u, 32u }) {
+            for (size_t lead = block - 5; lead <= block + 3; ++lead) {
+                // "Xxxx...x" + 연결자 + 단어  /  소문자 시작  /  토큰 밖 공백 구간 뒤
+                const std::string pad(lead - 1, 'a');
+                for (const std::string& text : {
+                         "b" + pad + j + "clock alpha",
+                         "don" + std::string(j) + "t " + std::string(lead, ' ') + "o" + j + "clock",
+                         std::string(lead, ' ') + "well" + j + "known. It" + j + "s " + j + "beta" + j,
+                         "Alpha " + pad + j + " " + j + j + "gamma" + j + "-delta" }) {
+                    SCOPED_TRACE(testing::Message() << "joiner=" << testing::PrintToString(std::string(j))
+                                                    << " lead=" << lead);
+                    expect_same(text);
+                    // 청크 경계가 연결자 바이트 한가운데 오는 경우 (보류 바이트 경로)
+                    for (size_t chunk = block - 2; chunk <= block + 2; ++chunk) expect_same(text, chunk);
+                }
+            }
+        }
+    }
+}
+
+TEST(TokenizerSimd, CaseAndSentenceFlagsAcrossBlocks) {
+    // 대문자/소문자 판정(any_lower)과 문장 시작 플래그가 블록 경계에서 끊겨도 같아야 함
+    std::string text;
+    for (size_t i = 0; i < 64; ++i) {
+        text += std::string(i % 17, ' ');
+        text += (i % 3 == 0) ? "Alpha" : (i % 3 == 1) ? "BETA" : "gAmma";
+        text += std::string(i % 33, 'q');
+        text += (i % 4 == 0) ? ". " : (i % 4 == 1) ? "\n\t" : "? ";
+    }
+    expect_same(text);
+    expect_same(text, 16);
+    expect_same(text, 31);
+}
+
+TEST(TokenizerSimd, StatsColumnsAcrossChapters) {
+    // 같은 단어가 여러 챕터에 나올 때 chapters / first_chapter / first_offset 까지 같은지
+    std::string text;
+    for (int i = 0; i < 40; ++i) text += std::string(size_t(i % 19), ' ') + "word tokens edge-block quote's ";
+    const size_t middle = text.size() / 2;
+    expect_same(text, 0, middle);
+    expect_same(text, 16, middle);
+
+    const Tokenized scalar = tokenize(text, false, 0, middle);
+    ASSERT_GT(scalar.stats.size(), 0u);
+    for (size_t k = 0; k < scalar.stats.size(); ++k) EXPECT_EQ(scalar.stats.chapters[k], 2u);
+}
+
+TEST(TokenizerSimd, StatsDifferenceNamesColumn) {
+    WordStats a;
+    a.add(1, 0, 0);
+    WordStats b = a;
+    EXPECT_EQ(stats_difference(a, b), nullptr);
+    b.counts[0] = 5;
+    EXPECT_STREQ(stats_difference(a, b), "counts");
+    b = a;
+    b.first_offset[0] = 9;
+    EXPECT_STREQ(stats_difference(a, b), "first_offset");
+}
+
+TEST(ShardedExtract, MatchesSequentialForEveryThreadCount) {
+    // 샤드 경계가 '.' 바로 뒤, 대문자 단어 뒤, 멀티바이트 연결자 옆에 오는 수 MB 텍스트에서
+    // threads=1..8 의 결과가 unique_words_fast 와 모든 열(ids, counts, first_offset, first_chapter, chapters,
+    // last_chapter)과 토큰 수까지 같아야 한다
+    ASSERT_FALSE(g_sample_text.empty());
+    const ShardText st = make_shard_text(4u << 20);
+    ASSERT_GE(st.text.size(), 4u << 20);
+    EXPECT_GE(st.seams, 20u);
+
+    for (const ChapterMarks* chapters : { &st.chapters, static_cast<const ChapterMarks*>(nullptr) }) {
+        size_t seq_tokens = 0;
+        const WordStats seq = extract_word_stats(st.text, 1, chapters, &seq_tokens);
+        ASSERT_GT(seq.size(), 0u);
+        if (chapters) {
+            // 여러 복사본(챕터)에 걸친 단어가 있어야 chapters 열 병합을 실제로 검사한다
+            EXPECT_TRUE(std::any_of(seq.chapters.begin(), seq.chapters.end(), [](uint32_t c) { return c > 1; }));
+        }
+        for (unsigned threads = 1; threads <= 8; ++threads) {
+            size_t tokens = 0;
+            const WordStats par = extract_word_stats(st.text, threads, chapters, &tokens);
+            const char* diff = stats_difference(seq, par);
+            EXPECT_EQ(diff, nullptr) << "threads=" << threads << " column " << (diff ? diff : "")
+                                     << (chapters ? "" : " (no chapters)");
+            EXPECT_EQ(tokens, seq_tokens) << "threads=" << threads;
+        }
+    }
+}
+
+TEST(ShardedExtract, SeamAfterSentenceEndKeepsTitleCaseWord) {
+    // 문장 끝 바로 뒤 경계: 다음 샤드 첫 단어는 문장 시작이므로 대문자여도 고유명사로 버리지 않는다.
+    // 경계 앞이 대문자 단어(문장 중간)면 그 뒤 대문자 단어는 고유명사로 빠진다 → 두 경우 모두 순차와 같아야 함
+    std::string text = std::string(64, 'x') + " gamma.";
+    text += std::string(64, ' ') + "Delta beta Alpha Beta gamma";
+    size_t seq_tokens = 0, par_tokens = 0;
+    const WordStats seq = extract_word_stats(text, 1, nullptr, &seq_tokens);
+    for (unsigned threads = 2; threads <= 8; ++threads) {
+        const WordStats par = extract_word_stats(text, threads, nullptr, &par_tokens);
+        const char* diff = stats_difference(seq, par);
+        EXPECT_EQ(diff, nullptr) << "threads=" << threads << " column " << (diff ? diff : "");
+        EXPECT_EQ(par_tokens, seq_tokens) << "threads=" << threads;
+    }
+    const auto words = sorted_words(seq);
+    EXPECT_TRUE(std::count(words.begin(), words.end(), "delta"));
+}
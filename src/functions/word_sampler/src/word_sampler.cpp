@@ -0,0 +1,46 @@
+#include "word_sampler.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <unordered_map>
+
+LemmaList::LemmaList(const std::filesystem::path& path) : file_(path) {
+    const char* p = file_.data();
+    const char* end = p + file_.size();
+    bool first = true;
+    while (p < end) {
+        const char* nl = static_cast<const char*>(std::memchr(p, '\n', (size_t)(end - p)));
+        const char* stop = nl ? nl : end;
+        const char* e = stop;
+        if (e > p && e[-1] == '\r') --e;
+        if (e > p) {
+            const bool header = first && std::all_of(p, e, [](char c) { return c >= '0' && c <= '9'; });
+            if (!header) lines_.push_back({ (size_t)(p - file_.data()), (uint32_t)(e - p) });
+            first = false;
+        }
+        p = stop + 1;
+    }
+}
+
+std::vector<std::string> LemmaList::sample(size_t k, uint64_t seed,
+                                           const std::function<bool(std::string_view)>& accept) const {
+    std::vector<std::string> out;
+    out.reserve(std::min(k, lines_.size()));
+    std::mt19937_64 rng(seed);
+
+    // 희소 Fisher–Yates: 가상의 순열 perm[0..n) 에서 바뀐 자리만 기록 (없으면 perm[i] == i)
+    std::unordered_map<size_t, size_t> moved;
+    auto at = [&](size_t i) {
+        auto it = moved.find(i);
+        return it == moved.end() ? i : it->second;
+    };
+    for (size_t i = 0; i < lines_.size() && out.size() < k; ++i) {
+        const size_t j = std::uniform_int_distribution<size_t>(i, lines_.size() - 1)(rng);
+        const size_t pick = at(j);
+        moved[j] = at(i);
+        const std::string_view w = (*this)[pick];
+        if (!accept || accept(w)) out.emplace_back(w);
+    }
+    return out;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mmap_file.hpp"
+
+// vocab_lemma.txt 에서 단어 k 개를 고르게 뽑기
+//
+// 파일은 한 번만 mmap 하고 줄 시작 위치/길이 색인을 만든다 (O(N), 한 번).
+// 그다음 뽑기는 색인 위의 희소 Fisher–Yates: 뽑은 자리만 해시맵에 기록하므로
+// 단어 k 개를 뽑는 데 O(k) (파일 크기와 무관, 백만 줄이어도 같다).
+// 첫 줄이 숫자뿐이면 lemmatize_list.py 가 쓰는 개수 머리줄로 보고 건너뛴다. 빈 줄은 무시.
+class LemmaList {
+public:
+    // 파일을 열 수 없으면 예외(std::runtime_error)
+    explicit LemmaList(const std::filesystem::path& path);
+
+    size_t size() const { return lines_.size(); }
+    bool empty() const { return lines_.empty(); }
+    std::string_view operator[](size_t i) const {
+        return std::string_view(file_.data() + lines_[i].offset, lines_[i].length);
+    }
+
+    // 서로 다른 줄을 무작위 순서로 뽑아 accept 를 통과한 것 최대 k 개 (단어가 모자라면 있는 만큼)
+    // accept 에 걸러진 줄은 다시 뽑히지 않는다
+    std::vector<std::string> sample(size_t k, uint64_t seed,
+                                    const std::function<bool(std::string_view)>& accept = {}) const;
+
+private:
+    struct Line {
+        size_t   offset;
+        uint32_t length;
+    };
+
+    MappedFile file_;
+    std::vector<Line> lines_;
+};
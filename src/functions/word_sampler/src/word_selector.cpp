@@ -0,0 +1,72 @@
+#include "word_selector.hpp"
+#include "../../lemmatizer/src/lemmatizer.hpp"
+#include "../../word_extractor/src/word_extractor.hpp"
+#include "../../zipf_filter/src/zipf_filter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <random>
+
+WordSelector::WordSelector(const WordStats& stats, const ZipfTable* zipf, Options opt)
+    : opt_(opt), zipf_(zipf) {
+    const Lemmatizer* lem = default_lemmatizer();
+    features_.reserve(stats.size());
+    for (size_t k = 0; k < stats.size(); ++k) {
+        const std::string_view word = dictionary_word(stats.ids[k]);
+        Features& f = features_[lem ? lem->lemma_of(word) : std::string(word)];
+        f.count += stats.counts[k];
+        f.chapters = std::max(f.chapters, stats.chapters[k]);
+        max_count_ = std::max(max_count_, f.count);
+        max_chapters_ = std::max(max_chapters_, f.chapters);
+    }
+}
+
+double WordSelector::score(std::string_view lemma) const {
+    double rarity = 0.5;
+    if (zipf_) {
+        const double z = zipf_->zipf(lemma);
+        rarity = z > 0 ? std::clamp(1.0 - z / 8.0, 0.0, 1.0) : 0.3;
+    }
+
+    // 통계에 없으면(파이썬 폴백 레마타이저와 원형이 다를 때 등) 한 번 나온 단어로 본다
+    uint32_t count = 1, chapters = 1;
+    auto it = features_.find(std::string(lemma));
+    if (it != features_.end()) {
+        count = std::max<uint32_t>(it->second.count, 1);
+        chapters = std::max<uint32_t>(it->second.chapters, 1);
+    }
+    const double frequency = std::log1p((double)count) / std::log1p((double)std::max(max_count_, count));
+    const double spread = (double)std::min(chapters, max_chapters_) / max_chapters_;
+
+    return opt_.w_rarity * rarity + opt_.w_frequency * frequency + opt_.w_spread * spread;
+}
+
+std::vector<std::string> WordSelector::select(const LemmaList& lemmas, size_t k, uint64_t seed,
+                                              const std::function<bool(std::string_view)>& accept) const {
+    if (k == 0) return {};
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> uni(0.0, 1.0);
+
+    // (키, 줄 번호) 최소 힙: top() 이 지금까지 상위 k 개 중 가장 약한 것
+    using Item = std::pair<double, size_t>;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> heap;
+    for (size_t i = 0; i < lemmas.size(); ++i) {
+        const std::string_view w = lemmas[i];
+        const double s = score(w);
+        double key = s;
+        if (opt_.mode == Mode::kWeighted) {
+            // log(u^(1/w)) = log(u) / w, w = exp(sharpness·s)
+            const double u = std::max(uni(rng), 1e-300);
+            key = std::log(u) * std::exp(-opt_.sharpness * s);
+        }
+        if (heap.size() == k && key <= heap.top().first) continue;
+        if (accept && !accept(w)) continue;
+        heap.emplace(key, i);
+        if (heap.size() > k) heap.pop();
+    }
+
+    std::vector<std::string> out(heap.size());
+    for (size_t j = out.size(); j-- > 0; heap.pop()) out[j] = std::string(lemmas[heap.top().second]);
+    return out;
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "word_sampler.hpp"
+
+struct WordStats;
+class ZipfTable;
+
+// 난이도 가중 단어 선택: 사전 조회 한 번에 더 쓸모 있는 단어를 고른다
+//
+// 원형마다 세 가지 특징을 [0, 1] 로 맞춰 가중합한 점수
+//   rarity    : 일반 영어에서 드문 정도 (1 - zipf/8, Zipf 표에 없으면 0.3 — 오타/고유명사일 가능성)
+//   frequency : 책 안 등장 횟수 log(1+count) / log(1+최대 횟수)
+//   spread    : 등장한 챕터 수 / 가장 넓게 퍼진 단어의 챕터 수
+// 통계는 추출기가 채운 WordStats 를 그대로 받는다 (vocab_stats.tsv 를 다시 읽지 않음).
+// 같은 원형으로 묶이는 단어들은 횟수는 합, 챕터 수는 최댓값.
+//
+// 고르기는 후보 N 개를 한 번 훑으면서 크기 k 의 최소 힙만 유지 (O(N log k))
+//   kTop      : 점수 상위 k 개
+//   kWeighted : 가중치 w = exp(sharpness · score) 로 비복원 가중 추출 (Efraimidis–Spirakis: 키 u^(1/w) 상위 k)
+class WordSelector {
+public:
+    enum class Mode { kTop, kWeighted };
+    struct Options {
+        Mode   mode = Mode::kWeighted;
+        double w_rarity = 0.5;
+        double w_frequency = 0.3;
+        double w_spread = 0.2;
+        double sharpness = 4.0;     // kWeighted: 클수록 상위 점수 쪽으로 몰림
+    };
+
+    // zipf 가 nullptr 이면 rarity 는 모두 같은 값
+    WordSelector(const WordStats& stats, const ZipfTable* zipf, Options opt);
+
+    double score(std::string_view lemma) const;
+
+    // lemmas 중 최대 k 개 (점수/키 높은 순). accept 는 힙에 들어갈 후보에만 불린다 (미스 캐시 조회 등)
+    std::vector<std::string> select(const LemmaList& lemmas, size_t k, uint64_t seed,
+                                    const std::function<bool(std::string_view)>& accept = {}) const;
+
+private:
+    struct Features {
+        uint32_t count = 0;
+        uint32_t chapters = 0;
+    };
+
+    Options opt_;
+    const ZipfTable* zipf_;
+    std::unordered_map<std::string, Features> features_;
+    uint32_t max_count_ = 1;
+    uint32_t max_chapters_ = 1;
+};
@@ -0,0 +1,197 @@
+#include "zipf_filter.hpp"
+#include "image_loader.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const char     kMagic[8] = { 'E','2','V','Z','I','P','F','\0' };
+const uint32_t kVersion  = 1;
+
+struct Header {
+    char     magic[8];
+    uint32_t version;
+    uint32_t words_size;    // 박혀 있는 WordList 이미지 바이트 수
+};
+static_assert(sizeof(Header) == 16, "unexpected Header padding");
+
+size_t align4(size_t n) { return (n + 3) & ~size_t(3); }
+
+uint8_t quantize(double zipf) {
+    const double q = std::floor(zipf * ZipfTable::kScale + 1e-9);
+    return q <= 0 ? 0 : q >= 255 ? 255 : (uint8_t)q;
+}
+
+const char kTableTxt[] = "zipf_en.txt";
+const char kTableBin[] = "zipf_en.bin";
+
+ZipfTable load_table_auto() {
+    std::string source;
+    ZipfTable zt = load_or_rebuild_image(kTableTxt, kTableBin, ZipfTable::from_table, ZipfTable::open_image, &source);
+    if (!source.empty())
+        std::cout << "[info] loaded " << zt.size() << " zipf entries from " << source << "\n";
+    return zt;
+}
+
+double g_max_zipf = 4.0;
+
+} // namespace
+
+ZipfTable ZipfTable::from_table(const fs::path& txt) {
+    std::ifstream in(txt, std::ios::binary);
+    if (!in) throw std::runtime_error("cannot open: " + txt.string());
+
+    std::vector<std::pair<std::string, uint8_t>> rows;
+    std::string line;
+    size_t line_no = 0;
+    while (std::getline(in, line)) {
+        ++line_no;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+        const size_t tab = line.find('\t');
+        if (tab == std::string::npos || tab == 0)
+            throw std::runtime_error("zipf table: bad line " + std::to_string(line_no));
+        double z = 0;
+        try {
+            z = std::stod(line.substr(tab + 1));
+        } catch (const std::exception&) {
+            throw std::runtime_error("zipf table: bad value on line " + std::to_string(line_no));
+        }
+        rows.emplace_back(line.substr(0, tab), quantize(z));
+    }
+
+    std::vector<std::string> names;
+    names.reserve(rows.size());
+    for (const auto& r : rows) names.push_back(r.first);
+    WordList words = WordList::from_words(std::move(names));
+    const uint32_t count = (uint32_t)words.size();
+
+    const std::string_view wimg = words.image();
+    const size_t off_words = sizeof(Header);
+    const size_t off_q     = align4(off_words + wimg.size());
+    const size_t total     = off_q + count;
+
+    std::vector<uint32_t> img((total + 3) / 4, 0);
+    char* base = reinterpret_cast<char*>(img.data());
+
+    Header h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = kVersion;
+    h.words_size = (uint32_t)wimg.size();
+    std::memcpy(base, &h, sizeof(h));
+    std::memcpy(base + off_words, wimg.data(), wimg.size());
+
+    // 같은 단어가 여러 번 나오면 큰 값 (wordfreq 표에는 중복이 없다)
+    uint8_t* q = reinterpret_cast<uint8_t*>(base + off_q);
+    for (const auto& [w, v] : rows) {
+        uint8_t& dst = q[(uint32_t)words.find(w)];
+        dst = std::max(dst, v);
+    }
+
+    ZipfTable zt;
+    zt.owned_ = std::move(img);
+    zt.bind(reinterpret_cast<const char*>(zt.owned_.data()), total);
+    return zt;
+}
+
+ZipfTable ZipfTable::open_image(const fs::path& path) {
+    ZipfTable zt;
+    zt.map_ = MappedFile(path);
+    zt.bind(zt.map_.data(), zt.map_.size());
+    return zt;
+}
+
+void ZipfTable::bind(const char* base, size_t size) {
+    Header h;
+    if (!base || size < sizeof(Header))
+        throw std::runtime_error("zipf image: truncated header");
+    std::memcpy(&h, base, sizeof(h));
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0 || h.version != kVersion)
+        throw std::runtime_error("zipf image: bad magic/version");
+    if (sizeof(Header) + size_t(h.words_size) > size)
+        throw std::runtime_error("zipf image: size mismatch");
+
+    WordList words = WordList::view(base + sizeof(Header), h.words_size);
+    const size_t off_q = align4(sizeof(Header) + h.words_size);
+    if (off_q + words.size() != size)
+        throw std::runtime_error("zipf image: size mismatch");
+
+    image_      = base;
+    image_size_ = size;
+    words_      = std::move(words);
+    q_          = reinterpret_cast<const uint8_t*>(base + off_q);
+}
+
+void ZipfTable::save_image(const fs::path& path) const {
+    if (!image_) throw std::runtime_error("zipf image: nothing to save");
+    fs::path tmp = path;
+    tmp += ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) throw std::runtime_error("failed to create: " + tmp.string());
+        out.write(image_, (std::streamsize)image_size_);
+        if (!out) throw std::runtime_error("failed to write: " + tmp.string());
+    }
+    fs::rename(tmp, path);
+}
+
+uint8_t ZipfTable::quantized(std::string_view w) const {
+    const int32_t id = words_.find(w);
+    return id >= 0 ? q_[id] : 0;
+}
+
+size_t ZipfTable::filter(std::vector<std::string>& words, double max_zipf) const {
+    // zipf < max_zipf  ⇔  q < ceil(max_zipf * kScale)   (임계값이 1/kScale 배수일 때 정확)
+    const double limit_d = std::ceil(max_zipf * kScale - 1e-9);
+    const unsigned limit = limit_d <= 0 ? 0u : limit_d > 256 ? 256u : (unsigned)limit_d;
+
+    // 블록 단위: 해시를 먼저 다 계산하고 슬롯을 프리페치한 뒤 조회 (캐시 미스 겹치기)
+    constexpr size_t kBlock = 32;
+    uint32_t hv[kBlock];
+    size_t w = 0;
+    for (size_t b = 0; b < words.size(); b += kBlock) {
+        const size_t n = std::min(kBlock, words.size() - b);
+        for (size_t k = 0; k < n; ++k) {
+            hv[k] = WordList::hash(words[b + k]);
+            words_.prefetch(hv[k]);
+        }
+        for (size_t k = 0; k < n; ++k) {
+            const int32_t id = words_.find(words[b + k], hv[k]);
+            const unsigned q = id >= 0 ? q_[id] : 0;
+            if (q < limit) {
+                if (w != b + k) words[w] = std::move(words[b + k]);
+                ++w;
+            }
+        }
+    }
+    const size_t removed = words.size() - w;
+    words.resize(w);
+    return removed;
+}
+
+const ZipfTable* default_zipf_table() {
+    static const ZipfTable zt = load_table_auto();
+    return zt.empty() ? nullptr : &zt;
+}
+
+int compile_zipf_image() {
+    const auto p = locate_data_file(kTableTxt);
+    if (p.empty()) {
+        std::cerr << "[warn] cannot find " << kTableTxt << " (tried CWD and exe dir; see py/zipf_dump.py)\n";
+        return 0;
+    }
+    ZipfTable zt = rebuild_image(p, ZipfTable::from_table);
+    std::cout << "[info] compiled " << zt.size() << " zipf entries → "
+              << image_path_for(p).string() << "\n";
+    return 1;
+}
+
+void set_max_zipf(double v) { g_max_zipf = v; }
+double max_zipf() { return g_max_zipf; }
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mmap_file.hpp"
+#include "../../word_extractor/src/wordlist_image.hpp"
+
+// lemmatize_list.py 의 filter_by_zipf (wordfreq.zipf_frequency < max_zipf 만 남김) 를 C++ 로
+//
+// 표 원본 zipf_en.txt (py/zipf_dump.py 가 wordfreq 에서 뽑아 냄)
+//   단어 <tab> zipf (소수 둘째 자리)
+//
+// 바이너리 이미지 zipf_en.bin (리틀 엔디언, 4바이트 정렬)
+//   Header                     : magic, version, words_size
+//   WordList image[words_size] : 표의 단어들 (id = 정렬 순서)
+//   uint8 q[count]             : floor(zipf * kScale), 255 에서 포화
+// 표에 없는 단어는 wordfreq 와 마찬가지로 zipf 0 으로 본다.
+class ZipfTable {
+public:
+    // 바이트 양자화 배율: 1/32 zipf 단위. 4.0 같은 1/32 배수 임계값은 원본과 정확히 같다
+    static constexpr double kScale = 32.0;
+
+    ZipfTable() = default;
+
+    // 텍스트 표를 파싱해 메모리 이미지를 만든다. 형식 오류는 예외(std::runtime_error)
+    static ZipfTable from_table(const std::filesystem::path& txt);
+    // 이미지 파일을 mmap 으로 연다. 형식이 맞지 않으면 예외(std::runtime_error)
+    static ZipfTable open_image(const std::filesystem::path& path);
+    // 현재 이미지를 파일로 저장 (임시 파일 → rename)
+    void save_image(const std::filesystem::path& path) const;
+
+    // 양자화된 zipf (표에 없으면 0)
+    uint8_t quantized(std::string_view w) const;
+    double zipf(std::string_view w) const { return quantized(w) / kScale; }
+
+    // zipf < max_zipf 인 단어만 남긴다 (순서 유지). 해시 계산/프리페치를 묶어서 조회
+    // return: 제거한 단어 수
+    size_t filter(std::vector<std::string>& words, double max_zipf) const;
+
+    size_t size() const { return words_.size(); }
+    bool empty() const { return words_.empty(); }
+    bool mapped() const { return !map_.empty(); }
+
+private:
+    void bind(const char* base, size_t size);
+
+    MappedFile  map_;               // mmap 백업 (open_image)
+    std::vector<uint32_t> owned_;   // 메모리 백업 (from_table)
+    const char* image_ = nullptr;
+    size_t      image_size_ = 0;
+
+    WordList       words_;
+    const uint8_t* q_ = nullptr;
+};
+
+// exe 옆(또는 CWD)의 zipf_en.bin/.txt 를 한 번만 열어 둔 인스턴스 (표가 없으면 nullptr)
+const ZipfTable* default_zipf_table();
+
+// zipf_en.txt → .bin 재생성. return: 만든 이미지 수 (0 = 표 없음)
+int compile_zipf_image();
+
+// 레마 출력에 적용할 임계값 (기본 4.0 = lemmatize_list.py, 0 이하 = 필터 끔)
+void set_max_zipf(double max_zipf);
+double max_zipf();
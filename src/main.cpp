@@ -1,18 +1,29 @@
 #include "functions/epub_reader/src/epub_reader.hpp"
 #include "functions/word_extractor/src/word_extractor.hpp"
 #include "functions/connect_dictionary/src/connect_dictionary.hpp"
+#include "functions/connect_dictionary/src/dictionary_response.hpp"
+#include "functions/connect_dictionary/src/offline_dictionary.hpp"
 #include "functions/send_telegram/src/send_telegram.hpp"
+#include "functions/batch_runner/src/batch_runner.hpp"
+#include "functions/lemmatizer/src/lemmatizer.hpp"
+#include "functions/zipf_filter/src/zipf_filter.hpp"
+#include "functions/lookup_pipeline/src/lookup_pipeline.hpp"
+#include "functions/word_sampler/src/word_sampler.hpp"
+#include "functions/word_sampler/src/word_selector.hpp"
+#include "functions/book_cache/src/book_cache.hpp"
 #include "py_runner/py_runner.hpp"
 
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <iomanip>
 #include <filesystem>
-#include <array>
 #include <vector>
-#include <numeric>   // iota
 #include <algorithm> // sample
 #include <random>
+#include <chrono>
+#include <optional>
+#include <limits>
 
 #ifdef _WIN32
   #include <windows.h>
@@ -31,95 +42,306 @@ static fs::path exe_dir() {
 #endif
 }
 
+static void print_usage() {
+    std::cerr << "Usage: epub2vocab [--stream] [--jobs N] [--no-simd] [--max-zipf X] [--select uniform|weighted|top]\n"
+                 "                  [--xhtml dom|stream] [--no-cache] <sample/sample.epub> [word count]\n"
+                 "       epub2vocab --check-simd <sample/sample.epub>\n"
+                 "       epub2vocab --check-xhtml <sample/sample.epub>\n"
+                 "       epub2vocab --batch <dir|list.txt> [--out <dir>] [--workers N] [--jobs N] [--no-cache]\n"
+                 "       epub2vocab --check-lemma <lemma_ref.tsv>\n"
+                 "       epub2vocab --compile-dict   (words/stopwords/wordnet_lemma/zipf_en .txt → .bin 이미지)\n";
+}
+
+// 숫자 옵션 값 (std::stoul 은 "-1" 을 큰 수로, "4x" 를 4 로 받아들이므로 끝까지 숫자인지 확인)
+static bool parse_unsigned(const std::string& s, unsigned& out) {
+    if (s.empty() || s[0] < '0' || s[0] > '9') return false;
+    try {
+        size_t used = 0;
+        const unsigned long v = std::stoul(s, &used);
+        if (used != s.size() || v > std::numeric_limits<unsigned>::max()) return false;
+        out = (unsigned)v;
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+static bool parse_double(const std::string& s, double& out) {
+    try {
+        size_t used = 0;
+        out = std::stod(s, &used);
+        return used == s.size();
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+static bool valid_select_mode(const std::string& s) {
+    return s == "uniform" || s == "weighted" || s == "top";
+}
+
+static bool parse_xhtml_parser(const std::string& s, XhtmlParser& out) {
+    if (s == "dom") out = XhtmlParser::kDom;
+    else if (s == "stream") out = XhtmlParser::kStream;
+    else return false;
+    return true;
+}
+
 int main(int argc, char* argv[]) {
-    if (argc < 2) {
-        std::cerr << "Usage: epub2vocab <sample/sample.epub>\n";
+    // 옵션과 위치 인자 분리
+    // --stream : 책 전체 텍스트를 만들지 않고 챕터 단위로 바로 단어 추출 (book_text.txt 생략)
+    // --jobs N : 챕터 inflate/parse + 단어 추출 샤드 병렬 워커 수 (기본 1, 0=코어 수)
+    // --batch <dir|list> : 여러 책을 한 프로세스에서 처리 (--out <dir>, --workers N)
+    // --no-simd : 토크나이저 스칼라 경로 강제 / --check-simd : 스칼라 vs SIMD 결과 비교만 하고 종료
+    // --xhtml dom|stream : 챕터 텍스트 추출 방식 (기본 dom = pugixml 트리, stream = DOM 없는 스캐너)
+    // --check-xhtml : 두 방식의 챕터 텍스트가 같은지 비교 + 속도 측정만 하고 종료
+    // --no-cache : 책 결과 캐시(book_cache/, EPUB 내용 해시 + 사전 지문 키)를 읽지도 쓰지도 않음
+    // --check-lemma <ref.tsv> : C++ 레마타이저를 파이썬 기준 출력(py/lemma_dump.py --ref)과 비교하고 종료
+    // --bench-json <dir> : 녹화한 사전 응답(*.json)으로 SAX 추출 vs DOM 결과 비교 + 속도 측정하고 종료
+    // --max-zipf X : 레마 출력에서 zipf >= X 인 쉬운 단어 제외 (기본 4.0, 0 = 필터 끔)
+    // --select uniform|weighted|top : 정의를 받을 단어 고르기 (기본 uniform = 균등 추출 + 추출 중 미리 조회,
+    //                                  weighted = 난이도 가중 추출, top = 점수 상위. 둘은 추출이 끝난 뒤에 조회)
+    bool stream_mode = false;
+    bool check_simd = false;
+    bool check_xhtml = false;
+    bool use_cache = true;
+    std::string select_mode = "uniform";
+    unsigned jobs = 1;
+    std::string batch_src;
+    BatchOptions batch;
+    std::vector<std::string> args;
+    // 값이 잘못된 옵션: 알려주고 사용법 출력
+    auto bad_value = [](const std::string& opt, const std::string& value) {
+        std::cerr << "invalid value for " << opt << ": " << value << "\n";
+        print_usage();
+        return 1;
+    };
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--stream") stream_mode = true;
+        else if (a == "--jobs" && i + 1 < argc) {
+            if (!parse_unsigned(argv[++i], jobs)) return bad_value(a, argv[i]);
+        }
+        else if (a.rfind("--jobs=", 0) == 0) {
+            if (!parse_unsigned(a.substr(7), jobs)) return bad_value("--jobs", a.substr(7));
+        }
+        else if (a == "--batch" && i + 1 < argc) batch_src = argv[++i];
+        else if (a == "--out" && i + 1 < argc) batch.out_dir = fs::u8path(argv[++i]);
+        else if (a == "--workers" && i + 1 < argc) {
+            if (!parse_unsigned(argv[++i], batch.workers)) return bad_value(a, argv[i]);
+        }
+        else if (a == "--compile-dict") {
+            const int built = compile_dictionary_images();
+            compile_lemma_image();   // 표(wordnet_lemma.txt, zipf_en.txt)는 선택 사항
+            compile_zipf_image();
+            compile_offline_dictionary();   // dictionary.jsonl (오프라인 사전 덤프) 도 선택 사항
+            return built == 2 ? 0 : 1;
+        }
+        else if (a == "--max-zipf" && i + 1 < argc) {
+            double max_zipf = 0;
+            if (!parse_double(argv[++i], max_zipf) || max_zipf < 0) return bad_value(a, argv[i]);
+            set_max_zipf(max_zipf);
+        }
+        else if (a.rfind("--max-zipf=", 0) == 0) {
+            double max_zipf = 0;
+            if (!parse_double(a.substr(11), max_zipf) || max_zipf < 0) return bad_value("--max-zipf", a.substr(11));
+            set_max_zipf(max_zipf);
+        }
+        else if (a == "--check-lemma" && i + 1 < argc) return verify_lemmatizer(fs::u8path(argv[++i])) ? 0 : 4;
+        else if (a == "--bench-json" && i + 1 < argc) return bench_dictionary_responses(fs::u8path(argv[++i])) ? 0 : 4;
+        else if (a == "--select" && i + 1 < argc) {
+            select_mode = argv[++i];
+            if (!valid_select_mode(select_mode)) return bad_value(a, select_mode);
+        }
+        else if (a.rfind("--select=", 0) == 0) {
+            select_mode = a.substr(9);
+            if (!valid_select_mode(select_mode)) return bad_value("--select", select_mode);
+        }
+        else if (a == "--no-simd") set_tokenizer_simd(false);
+        else if (a == "--check-simd") check_simd = true;
+        else if (a == "--xhtml" && i + 1 < argc) {
+            XhtmlParser parser;
+            if (!parse_xhtml_parser(argv[++i], parser)) return bad_value(a, argv[i]);
+            set_xhtml_parser(parser);
+        }
+        else if (a.rfind("--xhtml=", 0) == 0) {
+            XhtmlParser parser;
+            if (!parse_xhtml_parser(a.substr(8), parser)) return bad_value("--xhtml", a.substr(8));
+            set_xhtml_parser(parser);
+        }
+        else if (a == "--check-xhtml") check_xhtml = true;
+        else if (a == "--no-cache") use_cache = false;
+        else args.push_back(a);
+    }
+
+    if (!batch_src.empty()) {
+        try {
+            batch.jobs_per_book = jobs;
+            batch.use_cache = use_cache;
+            auto books = collect_epubs(fs::u8path(batch_src));
+            if (books.empty()) {
+                std::cerr << "no epub found in: " << batch_src << "\n";
+                return 1;
+            }
+            return run_batch(books, batch) == 0 ? 0 : 3;
+        } catch (const std::exception& e) {
+            std::cerr << "error: " << e.what() << "\n";
+            return 2;
+        }
+    }
+
+    if (args.empty()) {
+        print_usage();
         return 1;
     }
 
-    // argv[1] : epub 파일 경로
-    // argv[2] : (선택) 추출할 단어 개수 (기본 5개)
+    // args[0] : epub 파일 경로
+    // args[1] : (선택) 추출할 단어 개수 (기본 5개)
 
-    const char* path = argv[1];
+    const std::string path = args[0];
+    unsigned word_count = 5;
+    if (args.size() > 1 && (!parse_unsigned(args[1], word_count) || word_count == 0))
+        return bad_value("word count", args[1]);
 
     try {
         // exe 폴더 경로
         const fs::path exeDir = exe_dir();
 
-        // EPUB → 텍스트
-        std::string text = extract_epub_text(path);
-        std::cout << "text size: " << text.size() << " chars\n";
+        if (check_xhtml) return verify_xhtml_parser(path) ? 0 : 4;
+        if (check_simd) {
+            ChapterMarks chapters;
+            std::string text = extract_epub_text(path, jobs, &chapters);
+            return verify_tokenizer_simd(text, &chapters) ? 0 : 4;
+        }
+
+        // 사전 조회 단계: 균등 추출이고 원형 표가 있으면 I/O 스레드가 단어 추출과 동시에 후보 정의를 미리 받아 둔다
+        // (가중/상위 선택은 책 전체 통계가 있어야 점수가 정해지므로 추출이 끝난 뒤 한 번에 조회)
+        std::random_device seed_src;
+        const bool uniform_pick = select_mode == "uniform";
+        LookupPipeline lookups({ uniform_pick ? word_count : 0, (uint64_t(seed_src()) << 32) | seed_src() });
+        if (lookups.enabled()) set_new_word_hook([&lookups](uint32_t id) { lookups.on_word(id); });
 
-        // exe 옆에 저장
-        const fs::path bookTextPath = exeDir / "book_text.txt";
-        {
-            std::ofstream ofs(bookTextPath, std::ios::binary);
-            if (!ofs) throw std::runtime_error("failed to create: " + bookTextPath.string());
-            ofs << text;
+        WordStats bookStats;   // 단어 선택 점수용 (추출기가 채운 그대로)
+
+        // 결과 캐시: 같은 EPUB 바이트 + 같은 사전이면 zip/XML/토크나이저를 건너뛰고 저장해 둔 통계를 쓴다
+        const auto cacheMode = stream_mode ? BookCache::Mode::kStream : BookCache::Mode::kText;
+        std::optional<BookCache> cache;
+        BookCache::Key cacheKey;
+        BookCache::Entry cached;
+        bool cacheHit = false;
+        if (use_cache) {
+            const auto tc = std::chrono::steady_clock::now();
+            cache.emplace(BookCache::Options{ exeDir / "book_cache" });
+            cacheKey = BookCache::key_for(fs::u8path(path), cacheMode);
+            cacheHit = cache->get(cacheKey, cached);
+            if (cacheHit) {
+                std::cout << "[cache] hit " << cache->path_for(cacheKey).filename().string() << ": "
+                          << cached.stats.size() << " words (" << std::fixed << std::setprecision(1)
+                          << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tc).count()
+                          << " ms) — skipping zip/XML/tokenizer\n";
+            }
         }
-        std::cout << "[info] Saved full text to " << bookTextPath.string() << "\n";
 
-        // 단어 추출 (내부에서 exe 디렉토리 찾는 코드 없다면 필요시 넘겨도 OK)
-        word_extractor_main(text);
+        if (cacheHit) {
+            bookStats = std::move(cached.stats);
+            if (!stream_mode) {
+                std::cout << "text size: " << cached.text.size() << " chars\n";
+                const fs::path bookTextPath = exeDir / "book_text.txt";
+                std::ofstream ofs(bookTextPath, std::ios::binary);
+                if (!ofs) throw std::runtime_error("failed to create: " + bookTextPath.string());
+                ofs << cached.text;
+            }
+            write_vocab_file(exeDir / "vocab.txt", sorted_words(bookStats));
+            write_stats_file(exeDir / "vocab_stats.tsv", bookStats);
+        } else if (stream_mode) {
+            // EPUB → (챕터 단위) → 단어 추출
+            word_extractor_stream_main([&](WordStream& ws) {
+                extract_epub_text_stream(path, [&](const char* data, size_t n, size_t spine_index) {
+                    ws.begin_chapter((uint32_t)spine_index);
+                    ws.feed(data, n);
+                }, jobs);
+            }, &bookStats);
+            if (cache) cache->put(cacheKey, bookStats);
+        } else {
+            // EPUB → 텍스트 (+ 챕터 시작 위치)
+            ChapterMarks chapters;
+            std::string text = extract_epub_text(path, jobs, &chapters);
+            std::cout << "text size: " << text.size() << " chars\n";
+
+            // exe 옆에 저장
+            const fs::path bookTextPath = exeDir / "book_text.txt";
+            {
+                std::ofstream ofs(bookTextPath, std::ios::binary);
+                if (!ofs) throw std::runtime_error("failed to create: " + bookTextPath.string());
+                ofs << text;
+            }
+            std::cout << "[info] Saved full text to " << bookTextPath.string() << "\n";
+
+            // 단어 추출 (내부에서 exe 디렉토리 찾는 코드 없다면 필요시 넘겨도 OK)
+            word_extractor_main(text, jobs, &chapters, &bookStats);
+            if (cache) cache->put(cacheKey, bookStats, &chapters, &text);
+        }
+        set_new_word_hook(nullptr);
  
         std::cout << "[info] Saved unique words to vocab.txt\n";
 
-        // (선택) 파이썬 레마타이저 실행: vocab.txt → vocab_lemma.txt
-        run_lemmatizer(exeDir);
+        // 레마타이저: vocab.txt → vocab_lemma.txt (표가 없으면 파이썬 스크립트로 폴백)
+        lemmatize_vocab(exeDir);
 
         // (선택) 사전 API 연결: vocab_lemma.txt → definition.txt
         // vocab_lemma 읽기
         const fs::path vocabLemmaPath = exeDir / "vocab_lemma.txt";
 
-        // vocab_lemma에서 단어 하나 랜덤 뽑아서 connect_dictionary 실행
+        // vocab_lemma에서 단어 word_count 개 랜덤 뽑아서 정의 조회
         if (fs::exists(vocabLemmaPath)) {
-            std::ifstream ifs(vocabLemmaPath);
-            std::string line;
-
-            // vocab_lemma 단어 개수 확인 (vocab lemma 첫번째 줄은 단어 개수)
-            int wordsLength = 0;
-            if (std::getline(ifs, line)) {
-                try {
-                    wordsLength = std::stoi(line);
-                } catch (...) {
-                    wordsLength = 0;
-                }
-            }
+            // 한 번 mmap + 줄 색인 (vocab lemma 첫번째 줄은 단어 개수라 건너뜀)
+            const LemmaList lemmaList(vocabLemmaPath);
 
-            
-            // target 단어 개수
-            std::array<int, 5> targetWords;
-
-            std::vector<int> idx(wordsLength - 1);
-            std::iota(idx.begin(), idx.end(), 1);  // 1..(wordsLength-1)
-
-            std::random_device rd;
-            std::mt19937 gen(rd());
-            std::shuffle(idx.begin(), idx.end(), gen);
+            std::vector<std::string> targets;
+            std::vector<std::string> definitions;
+            if (lookups.enabled()) {
+                // 최종 원형 목록에서 고르고, 추출 중에 미리 받아 둔 정의는 그대로 쓴다
+                std::vector<std::string> lemmas;
+                lemmas.reserve(lemmaList.size());
+                for (size_t i = 0; i < lemmaList.size(); ++i) lemmas.emplace_back(lemmaList[i]);
+                for (auto& pick : lookups.finish(lemmas)) {
+                    targets.push_back(std::move(pick.lemma));
+                    definitions.push_back(std::move(pick.definition));
+                }
+            } else {
+                // 뽑은 단어를 먼저 모으고, 정의는 한 번에 동시 요청
+                // 지난 실행에서 정의가 없던 단어(미스 캐시)는 건너뛰고 다음 후보로
+                size_t skipped = 0;
+                auto not_missed = [&skipped](std::string_view w) {
+                    if (!known_miss(std::string(w))) return true;
+                    ++skipped;
+                    return false;
+                };
+                const uint64_t seed = (uint64_t(seed_src()) << 32) | seed_src();
+                if (uniform_pick) {
+                    targets = lemmaList.sample(word_count, seed, not_missed);
+                } else {
+                    WordSelector::Options opt;
+                    opt.mode = select_mode == "top" ? WordSelector::Mode::kTop : WordSelector::Mode::kWeighted;
+                    const WordSelector selector(bookStats, default_zipf_table(), opt);
+                    targets = selector.select(lemmaList, word_count, seed, not_missed);
+                    std::cout << "[info] selected (" << (opt.mode == WordSelector::Mode::kTop ? "top" : "weighted") << "):";
+                    for (const auto& t : targets) std::cout << " " << t << " (" << std::setprecision(2) << selector.score(t) << ")";
+                    std::cout << "\n";
+                }
+                if (skipped) std::cout << "[info] skipped " << skipped << " known misses\n";
 
-            for (int i = 0; i < 5; ++i) targetWords[i] = idx[i];
-            
-            int count = 0;
+                definitions = print_definitions(targets);
+            }
 
             std::string wholeLines;
-            for (int target : targetWords) {
-                ifs.clear();
-                ifs.seekg(0, std::ios::beg);
-                count = 0;
-                while (std::getline(ifs, line)) {
-                    if (!line.empty()) {
-                        if (count == target) {
-                            std::string response = print_definition(line);
-                            wholeLines += response + "\n";
-                            wholeLines += "----------------------\n";
-                            std::cout << "[info] Saved definitions to definition.txt\n";
-                            break;
-                        }
-                        count++;
-                    }
-                }
+            for (const auto& response : definitions) {
+                wholeLines += response + "\n";
+                wholeLines += "----------------------\n";
             }
+            std::cout << "[info] Saved definitions to definition.txt\n";
             save_to_file((exeDir / "definition.txt").string(), wholeLines);
+            print_definition_cache_stats();
         }
 
         const fs::path defPath = exeDir / "definition.txt";